@@ -0,0 +1,55 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Atom.h"
+
+#include <mutex>
+#include <unordered_set>
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+namespace {
+
+struct AtomTable
+{
+    std::mutex mutex;
+    std::unordered_set<std::u16string> names;
+};
+
+AtomTable& getAtomTable()
+{
+    static AtomTable table;
+    return table;
+}
+
+}
+
+const std::u16string* Atom::intern(const std::u16string& name)
+{
+    if (name.empty())
+        return 0;
+    AtomTable& table = getAtomTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return &*table.names.insert(name).first;
+}
+
+const std::u16string& Atom::str() const
+{
+    static const std::u16string empty;
+    return name ? *name : empty;
+}
+
+}}}}  // org::w3c::dom::bootstrap
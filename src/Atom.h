@@ -0,0 +1,72 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES_ATOM_H_INCLUDED
+#define ES_ATOM_H_INCLUDED
+
+#include <functional>
+#include <string>
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+// An Atom is a name interned in a process-wide table, so that atoms can be
+// compared and hashed by identity. Interning is thread-safe, and interned
+// names are never freed.
+class Atom
+{
+    const std::u16string* name;  // 0 for the empty name
+
+    static const std::u16string* intern(const std::u16string& name);
+
+public:
+    Atom() :
+        name(0)
+    {}
+    explicit Atom(const std::u16string& name) :
+        name(intern(name))
+    {}
+
+    const std::u16string& str() const;
+    bool empty() const {
+        return !name;
+    }
+
+    bool operator==(const Atom& other) const {
+        return name == other.name;
+    }
+    bool operator!=(const Atom& other) const {
+        return name != other.name;
+    }
+    size_t hash() const {
+        return std::hash<const void*>()(name);
+    }
+};
+
+}}}}  // org::w3c::dom::bootstrap
+
+namespace std {
+
+template<>
+struct hash<org::w3c::dom::bootstrap::Atom>
+{
+    size_t operator()(const org::w3c::dom::bootstrap::Atom& atom) const {
+        return atom.hash();
+    }
+};
+
+}
+
+#endif  // ES_ATOM_H_INCLUDED
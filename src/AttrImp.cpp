@@ -20,6 +20,8 @@
 
 #include <new>
 
+#include "ElementImp.h"
+
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
 // Attr
@@ -50,12 +52,18 @@ std::u16string AttrImp::getValue()
     return value;
 }
 
+// The value is set through the owner element so that the element can keep
+// its ID index and the DOM version up to date.
 void AttrImp::setValue(const std::u16string& value)
 {
-    this->value = value;
+    if (ownerElement)
+        ownerElement->setAttributeNS(namespaceURI, getName(), value);
+    else
+        this->value = value;
 }
 
-AttrImp::AttrImp(Nullable<std::u16string> namespaceURI, Nullable<std::u16string> prefix, const std::u16string& localName, const std::u16string& value) :
+AttrImp::AttrImp(ElementImp* ownerElement, Nullable<std::u16string> namespaceURI, Nullable<std::u16string> prefix, const std::u16string& localName, const std::u16string& value) :
+    ownerElement(ownerElement),
     namespaceURI(namespaceURI),
     prefix(prefix),
     localName(localName),
@@ -22,16 +22,21 @@
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
+class ElementImp;
+
 class AttrImp : public ObjectMixin<AttrImp>
 {
+    friend class ElementImp;
+
 private:
+    ElementImp* ownerElement;   // 0 once the attribute has been removed
     Nullable<std::u16string> namespaceURI;
     Nullable<std::u16string> prefix;
     std::u16string localName;
     std::u16string value;
 
 public:
-    AttrImp(Nullable<std::u16string> namespaceURI, Nullable<std::u16string> prefix, const std::u16string& localName, const std::u16string& value);
+    AttrImp(ElementImp* ownerElement, Nullable<std::u16string> namespaceURI, Nullable<std::u16string> prefix, const std::u16string& localName, const std::u16string& value);
 
     // Attr
     virtual Nullable<std::u16string> getNamespaceURI();
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Tests the ID index of a document and the live collections keep up with
+// the later changes to the document tree.
+
+#include <org/w3c/dom/Attr.h>
+#include <org/w3c/dom/Document.h>
+#include <org/w3c/dom/Element.h>
+#include <org/w3c/dom/html/HTMLCollection.h>
+
+#include <iostream>
+
+#include "Test.util.h"
+
+using namespace org::w3c::dom;
+
+namespace {
+
+const char* html =
+    "<!DOCTYPE html><html><body id='body'>"
+    "<p id='a' class='x'>one</p>"
+    "<p id='dup'>two</p>"
+    "<div><p id='dup' class='x y'>three</p></div>"
+    "</body></html>";
+
+int testElementId()
+{
+    int rc = EXIT_SUCCESS;
+    Document document = loadDocument(html);
+    Element body = document.getElementById(u"body");
+    Element a = document.getElementById(u"a");
+    rc |= checkResult("parsed", body && a && a.getTextContent().value() == u"one");
+
+    Element div = document.createElement(u"div");
+    div.setAttribute(u"id", u"new");
+    Element span = document.createElement(u"span");
+    span.setAttribute(u"id", u"inner");
+    div.appendChild(span);
+    rc |= checkResult("not in the document", !document.getElementById(u"new") && !document.getElementById(u"inner"));
+
+    body.appendChild(div);
+    rc |= checkResult("inserted", document.getElementById(u"new") == div && document.getElementById(u"inner") == span);
+
+    body.removeChild(div);
+    rc |= checkResult("removed", !document.getElementById(u"new") && !document.getElementById(u"inner"));
+
+    a.setAttribute(u"id", u"b");
+    rc |= checkResult("id changed", !document.getElementById(u"a") && document.getElementById(u"b") == a);
+
+    Attr attr = a.getAttributeNode(u"id");
+    attr.setValue(u"c");
+    rc |= checkResult("Attr value changed", !document.getElementById(u"b") && document.getElementById(u"c") == a &&
+                                            a.getAttribute(u"id").value() == u"c");
+
+    a.removeAttribute(u"id");
+    rc |= checkResult("id removed", !document.getElementById(u"c"));
+
+    Element dup = document.getElementById(u"dup");
+    rc |= checkResult("first in tree order", dup && dup.getTextContent().value() == u"two");
+    body.removeChild(dup);
+    dup = document.getElementById(u"dup");
+    rc |= checkResult("next in tree order", dup && dup.getTextContent().value() == u"three");
+    return rc;
+}
+
+int testLiveCollection()
+{
+    int rc = EXIT_SUCCESS;
+    Document document = loadDocument(html);
+    Element body = document.getElementById(u"body");
+    html::HTMLCollection paragraphs = document.getElementsByTagName(u"p");
+    html::HTMLCollection classes = document.getElementsByClassName(u"x");
+    html::HTMLCollection spans = body.getElementsByTagName(u"span");
+    rc |= checkResult("collected", paragraphs.getLength() == 3 && classes.getLength() == 2 && spans.getLength() == 0);
+
+    Element p = document.createElement(u"p");
+    body.appendChild(p);
+    rc |= checkResult("element appended", paragraphs.getLength() == 4 && paragraphs.item(3) == p);
+
+    Element span = document.createElement(u"span");
+    p.appendChild(span);
+    rc |= checkResult("descendant appended", spans.getLength() == 1 && spans.item(0) == span);
+
+    p.setAttribute(u"class", u"y x");
+    rc |= checkResult("class added", classes.getLength() == 3 && classes.item(2) == p);
+
+    Element a = document.getElementById(u"a");
+    a.setAttribute(u"class", u"z");
+    rc |= checkResult("class changed", classes.getLength() == 2 && classes.item(1) == p);
+
+    body.removeChild(a);
+    rc |= checkResult("element removed", paragraphs.getLength() == 3 && paragraphs.item(0) != a);
+
+    rc |= checkResult("named item", paragraphs.namedItem(u"dup") && !paragraphs.namedItem(u"a"));
+    return rc;
+}
+
+}  // namespace
+
+int main()
+{
+    int rc = EXIT_SUCCESS;
+    rc |= testElementId();
+    rc |= testLiveCollection();
+    return rc;
+}
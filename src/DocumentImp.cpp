@@ -19,6 +19,7 @@
 #include <time.h>
 
 #include <algorithm>
+#include <iterator>
 #include <new>
 #include <vector>
 #include <boost/bind.hpp>
@@ -70,6 +71,7 @@
 #include "html/HTMLLegendElementImp.h"
 #include "html/HTMLLIElementImp.h"
 #include "html/HTMLLinkElementImp.h"
+#include "html/HTMLLiveCollectionImp.h"
 #include "html/HTMLMapElementImp.h"
 #include "html/HTMLMarqueeElementImp.h"
 #include "html/HTMLMenuElementImp.h"
@@ -124,13 +126,16 @@ DocumentImp::DocumentImp(const std::u16string& url) :
     pendingParsingBlockingScript(0),
     defaultView(0),
     activeElement(0),
-    error(0)
+    error(0),
+    domVersion(0)
 {
     nodeName = u"#document";
 }
 
 DocumentImp::~DocumentImp()
 {
+    for (auto i = liveCollections.begin(); i != liveCollections.end(); ++i)
+        i->second->document = 0;
 }
 
 void DocumentImp::setEventHandler(const std::u16string& type, Object handler)
@@ -311,7 +316,7 @@ Element DocumentImp::getDocumentElement()
 
 html::HTMLCollection DocumentImp::getElementsByTagName(const std::u16string& localName)
 {
-    return ElementImp::getElementsByTagName(dynamic_cast<ElementImp*>(getDocumentElement().self()), localName);
+    return getLiveCollection(this, HTMLLiveCollectionImp::TagName, localName);
 }
 
 html::HTMLCollection DocumentImp::getElementsByTagNameNS(const Nullable<std::u16string>& _namespace, const std::u16string& localName)
@@ -322,12 +327,63 @@ html::HTMLCollection DocumentImp::getElementsByTagNameNS(const Nullable<std::u16
 
 html::HTMLCollection DocumentImp::getElementsByClassName(const std::u16string& classNames)
 {
-    return ElementImp::getElementsByClassName(dynamic_cast<ElementImp*>(getDocumentElement().self()), classNames);
+    return getLiveCollection(this, HTMLLiveCollectionImp::ClassName, classNames);
+}
+
+html::HTMLCollection DocumentImp::getLiveCollection(NodeImp* root, int type, const std::u16string& key)
+{
+    auto k = std::make_tuple(root, type, key);
+    auto found = liveCollections.find(k);
+    if (found != liveCollections.end())
+        return found->second;
+    HTMLLiveCollectionImp* collection = new(std::nothrow) HTMLLiveCollectionImp(root, this, type, key);
+    if (collection)
+        liveCollections.insert(std::make_pair(k, collection));
+    return collection;
+}
+
+void DocumentImp::removeLiveCollection(HTMLLiveCollectionImp* collection)
+{
+    auto found = liveCollections.find(std::make_tuple(collection->root.get(), collection->type, collection->key));
+    if (found != liveCollections.end() && found->second == collection)
+        liveCollections.erase(found);
+}
+
+void DocumentImp::removeElementId(const std::u16string& id, ElementImp* element)
+{
+    auto range = idMap.equal_range(id);
+    for (auto i = range.first; i != range.second; ++i) {
+        if (i->second == element) {
+            idMap.erase(i);
+            return;
+        }
+    }
+}
+
+size_t DocumentImp::findElementId(const std::u16string& id, ElementImp*& element)
+{
+    auto range = idMap.equal_range(id);
+    if (range.first == range.second) {
+        element = 0;
+        return 0;
+    }
+    element = range.first->second;
+    return std::distance(range.first, range.second);
 }
 
 Element DocumentImp::getElementById(const std::u16string& elementId)
 {
-    ElementImp* e = dynamic_cast<ElementImp*>(getDocumentElement().self());
+    ElementImp* e;
+    switch (findElementId(elementId, e)) {
+    case 0:
+        return 0;
+    case 1:
+        return e;
+    default:
+        break;
+    }
+    // Find the first one in tree order.
+    e = dynamic_cast<ElementImp*>(getDocumentElement().self());
     while (e) {
         Nullable<std::u16string> id = e->getAttribute(u"id");
         if (id.hasValue() && id.value() == elementId)
@@ -53,6 +53,9 @@
 
 #include <deque>
 #include <list>
+#include <map>
+#include <tuple>
+#include <unordered_map>
 
 #include "NodeImp.h"
 #include "DocumentWindow.h"
@@ -64,6 +67,8 @@ class HTMLTokenizer;
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
+class HTMLLiveCollectionImp;
+
 class DocumentImp : public ObjectMixin<DocumentImp, NodeImp>
 {
     std::u16string url;
@@ -93,6 +98,14 @@ class DocumentImp : public ObjectMixin<DocumentImp, NodeImp>
     // XBL 2.0
     std::map<const std::u16string, html::Window> bindingDocuments;
 
+    // The elements in the document tree indexed by their IDs
+    std::unordered_multimap<std::u16string, ElementImp*> idMap;
+
+    // Incremented whenever the document is modified in a way that could
+    // change the members of the live collections.
+    unsigned domVersion;
+    std::map<std::tuple<NodeImp*, int, std::u16string>, HTMLLiveCollectionImp*> liveCollections;
+
     bool processScripts(std::list<html::HTMLScriptElement>& scripts);
     void write(const Variadic<std::u16string>& text, bool linefeed);
 
@@ -100,6 +113,17 @@ public:
     DocumentImp(const std::u16string& url = u"about:blank");
     ~DocumentImp();
 
+    // The document tree has been freed by the time the document itself is
+    // deallocated; return the chunks it has emptied at once.
+    static void operator delete(void* p) {
+        NodeArena::deallocate(p);
+        NodeArena::release();
+    }
+    static void operator delete(void* p, const std::nothrow_t&) {
+        NodeArena::deallocate(p);
+        NodeArena::release();
+    }
+
     enum
     {
          NoQuirksMode,  // default
@@ -107,6 +131,25 @@ public:
          LimitedQuirksMode
     };
 
+    void addElementId(const std::u16string& id, ElementImp* element) {
+        idMap.insert(std::make_pair(id, element));
+    }
+    void removeElementId(const std::u16string& id, ElementImp* element);
+    // Returns the number of the elements with the ID in the document tree,
+    // and one of them in element.
+    size_t findElementId(const std::u16string& id, ElementImp*& element);
+
+    unsigned getDOMVersion() const {
+        return domVersion;
+    }
+    void updateDOMVersion() {
+        ++domVersion;
+    }
+    // Returns the live collection of the descendants of root, which is
+    // shared by the callers with the same arguments.
+    html::HTMLCollection getLiveCollection(NodeImp* root, int type, const std::u16string& key);
+    void removeLiveCollection(HTMLLiveCollectionImp* collection);
+
     WindowImp* getDefaultWindow() const {
         return defaultView;
     }
@@ -24,6 +24,8 @@
 #include "ECMAScript.h"
 #include "WindowImp.h"
 #include "css/ViewCSSImp.h"
+#include "html/HTMLAnchorElementImp.h"
+#include "http/HTTPConnection.h"
 
 #include "Test.util.h"
 
@@ -95,7 +97,7 @@ void DocumentWindow::setEventHandler(const std::u16string& type, Object handler)
     }
 }
 
-HttpRequest* DocumentWindow::preload(const std::u16string& base, const std::u16string& urlString)
+HttpRequest* DocumentWindow::preload(const std::u16string& base, const std::u16string& urlString, unsigned short priority)
 {
     URL url(base, urlString);
     if (url.isEmpty())
@@ -111,6 +113,7 @@ HttpRequest* DocumentWindow::preload(const std::u16string& base, const std::u16s
     if (request) {
         cache.push_back(request);
         request->open(u"GET", urlString);
+        request->setPriority(priority);
         request->setHandler(boost::bind(&DocumentWindow::notify, this));
         if (DocumentImp* imp = dynamic_cast<DocumentImp*>(document.self()))
             imp->incrementLoadEventDelayCount();
@@ -119,6 +122,17 @@ HttpRequest* DocumentWindow::preload(const std::u16string& base, const std::u16s
     return request;
 }
 
+void DocumentWindow::preconnect(const std::u16string& base, const std::u16string& urlString, bool connect)
+{
+    URL url(base, urlString);
+    if (url.isEmpty())
+        return;
+    if (connect)
+        HttpConnectionManager::getInstance().preconnect(url);
+    else
+        HttpConnectionManager::getInstance().preresolve(url);
+}
+
 void DocumentWindow::notify()
 {
     if (DocumentImp* imp = dynamic_cast<DocumentImp*>(document.self()))
@@ -195,6 +209,18 @@ void DocumentWindow::handleMouseMove(EventListenerImp* listener, events::Event e
 
     moveX = mouse.getScreenX();
     moveY = mouse.getScreenY();
+
+    // A hovered link is likely to be followed soon.
+    for (Node node = interface_cast<Node>(event.getTarget()); node; node = node.getParentNode()) {
+        if (auto anchor = dynamic_cast<HTMLAnchorElementImp*>(node.self())) {
+            std::u16string href = anchor->getHref();
+            if (!href.empty() && href != hoveredHref) {
+                hoveredHref = href;
+                preconnect(document.getDocumentURI(), href);
+            }
+            break;
+        }
+    }
 }
 
 }}}}  // org::w3c::dom::bootstrap
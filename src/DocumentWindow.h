@@ -29,11 +29,11 @@
 #include "EventTargetImp.h"
 #include "ECMAScript.h"
 #include "Task.h"
+#include "http/HTTPRequest.h"
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
 class WindowImp;
-class HttpRequest;
 
 // DocumentWindow implements the Window object
 class DocumentWindow : public EventTargetImp
@@ -46,6 +46,7 @@ class DocumentWindow : public EventTargetImp
     int scrollY;
     int moveX;
     int moveY;
+    std::u16string hoveredHref;     // the last link preconnected by hovering
     Retained<EventListenerImp> clickListener;
     Retained<EventListenerImp> mouseMoveListener;
 
@@ -80,7 +81,10 @@ public:
 
     void setEventHandler(const std::u16string& type, Object handler);
 
-    HttpRequest* preload(const std::u16string& base, const std::u16string& url);
+    HttpRequest* preload(const std::u16string& base, const std::u16string& url, unsigned short priority = HttpRequest::LOW_PRIORITY);
+    // Warms up the connection to the origin of the specified URL. If connect
+    // is false, only the host name is resolved.
+    void preconnect(const std::u16string& base, const std::u16string& url, bool connect = true);
 
     // CSSOM View
     int getScrollX() const {
@@ -32,7 +32,7 @@
 #include "NodeListImp.h"
 #include "XMLDocumentImp.h"
 #include "css/CSSSerialize.h"
-#include "html/HTMLCollectionImp.h"
+#include "html/HTMLLiveCollectionImp.h"
 #include "html/HTMLTokenizer.h"
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
@@ -49,7 +49,7 @@ public:
     virtual Attr getElement(unsigned int index) {
         if (element->attributes.size() <= index)
             return 0;
-        return element->attributes[index];
+        return element->getAttr(element->attributes[index]);
     }
     virtual void setElement(unsigned int index, Attr value) {
     }
@@ -63,12 +63,93 @@ public:
     }
 };
 
-void ElementImp::setAttributes(const std::deque<Attr>& attributes)
+std::u16string ElementImp::InlineAttr::getLocalName() const
 {
+    size_t pos = name.find(u':');
+    if (pos == std::u16string::npos)
+        return name;
+    return name.substr(pos + 1);
+}
+
+void ElementImp::InlineAttr::setValue(const std::u16string& value)
+{
+    this->value = value;
+    if (attr)
+        static_cast<AttrImp*>(attr.self())->value = value;
+}
+
+// Lets the Attr node outlive the element, or its removal from the element.
+void ElementImp::InlineAttr::detach()
+{
+    if (attr)
+        static_cast<AttrImp*>(attr.self())->ownerElement = 0;
+}
+
+ElementImp::InlineAttr* ElementImp::findAttribute(const std::u16string& name)
+{
+    for (auto i = attributes.begin(); i != attributes.end(); ++i) {
+        if (i->name == name)
+            return &*i;
+    }
+    return 0;
+}
+
+ElementImp::InlineAttr* ElementImp::findAttributeNS(const Nullable<std::u16string>& namespaceURI, const std::u16string& localName)
+{
+    std::u16string uri = static_cast<std::u16string>(namespaceURI);
     for (auto i = attributes.begin(); i != attributes.end(); ++i) {
-        Attr attr = *i;
-        setAttributeNS(attr.getNamespaceURI(), attr.getName(), attr.getValue());
+        if (i->namespaceURI == uri && i->getLocalName() == localName)
+            return &*i;
+    }
+    return 0;
+}
+
+Attr ElementImp::getAttr(InlineAttr& attribute)
+{
+    if (!attribute.attr) {
+        Nullable<std::u16string> namespaceURI;
+        Nullable<std::u16string> prefix;
+        std::u16string localName(attribute.name);
+        if (!attribute.namespaceURI.empty())
+            namespaceURI = attribute.namespaceURI;
+        size_t pos = localName.find(u':');
+        if (pos != std::u16string::npos) {
+            prefix = localName.substr(0, pos);
+            localName.erase(0, pos + 1);
+        }
+        attribute.attr = new(std::nothrow) AttrImp(this, namespaceURI, prefix, localName, attribute.value);
     }
+    return attribute.attr;
+}
+
+// Note the event carries the Attr node only if it has already been created;
+// creating one for every attribute change would defeat the inline storage.
+void ElementImp::dispatchAttrModified(const Attr& attr, const std::u16string& prevValue, const std::u16string& newValue, const std::u16string& name, unsigned short change)
+{
+    events::MutationEvent event = new(std::nothrow) MutationEventImp;
+    event.initMutationEvent(u"DOMAttrModified",
+                            true, false, attr, prevValue, newValue, name, change);
+    dispatchEvent(event);
+}
+
+void ElementImp::setAttributes(const std::vector<Attribute>& list)
+{
+    attributes.reserve(attributes.size() + list.size());
+    for (auto i = list.begin(); i != list.end(); ++i)
+        setAttribute(i->getName(), i->getValue());
+}
+
+void ElementImp::updateElementId(const Nullable<std::u16string>& prevId, const Nullable<std::u16string>& id)
+{
+    if (prevId == id)
+        return;
+    DocumentImp* document = getDocumentTree();
+    if (!document)
+        return;
+    if (prevId.hasValue())
+        document->removeElementId(prevId.value(), this);
+    if (id.hasValue())
+        document->addElementId(id.value(), this);
 }
 
 ElementImp* ElementImp::getNextElement(ElementImp* root)
@@ -144,7 +225,7 @@ bool ElementImp::isEqualNode(Node arg)
         bool found = false;
         for (auto j = element->attributes.begin(); j != element->attributes.end(); ++j) {
             if (i->getLocalName() == j->getLocalName()) {
-                if (i->getNamespaceURI() != j->getNamespaceURI())
+                if (i->namespaceURI != j->namespaceURI)
                     break;
                 if (i->getValue() != j->getValue())
                     break;
@@ -171,7 +252,7 @@ Nullable<std::u16string> ElementImp::getPrefix()
 
 std::u16string ElementImp::getLocalName()
 {
-    return localName;
+    return localName.str();
 }
 
 std::u16string ElementImp::getTagName()
@@ -181,7 +262,10 @@ std::u16string ElementImp::getTagName()
 
 std::u16string ElementImp::getId()
 {
-    return getAttribute(u"id");
+    static const std::u16string id(u"id");
+    if (InlineAttr* attr = findAttribute(id))
+        return attr->getValue();
+    return u"";
 }
 
 void ElementImp::setId(const std::u16string& id)
@@ -191,7 +275,10 @@ void ElementImp::setId(const std::u16string& id)
 
 std::u16string ElementImp::getClassName()
 {
-    return getAttribute(u"class");
+    static const std::u16string className(u"class");
+    if (InlineAttr* attr = findAttribute(className))
+        return attr->getValue();
+    return u"";
 }
 
 void ElementImp::setClassName(const std::u16string& className)
@@ -214,21 +301,15 @@ Nullable<std::u16string> ElementImp::getAttribute(const std::u16string& name)
     // TODO: If the context node is in the HTML namespace and its ownerDocument is an HTML document
     std::u16string n(name);
         toLower(n);
-    for (auto i = attributes.begin(); i != attributes.end(); ++i) {
-        Attr attr = *i;
-        if (attr.getName() == n)
-            return attr.getValue();
-    }
+    if (InlineAttr* attr = findAttribute(n))
+        return attr->getValue();
     return Nullable<std::u16string>();
 }
 
 Nullable<std::u16string> ElementImp::getAttributeNS(const Nullable<std::u16string>& namespaceURI, const std::u16string& localName)
 {
-    for (auto i = attributes.begin(); i != attributes.end(); ++i) {
-        Attr attr = *i;
-        if (static_cast<std::u16string>(attr.getNamespaceURI()) == static_cast<std::u16string>(namespaceURI) && attr.getLocalName() == localName)
-            return attr.getValue();
-    }
+    if (InlineAttr* attr = findAttributeNS(namespaceURI, localName))
+        return attr->getValue();
     return Nullable<std::u16string>();
 }
 
@@ -239,27 +320,25 @@ void ElementImp::setAttribute(const std::u16string& name, const std::u16string&
     std::u16string n(name);
         toLower(n);
     // TODO: If qualifiedName starts with "xmlns", raise a NAMESPACE_ERR and terminate these steps.
-    for (auto i = attributes.begin(); i != attributes.end(); ++i) {
-        Attr attr = *i;
-        if (attr.getName() == n) {
-            std::u16string prevValue = attr.getValue();
-            if (prevValue != value) {
-                attr.setValue(value);
-                events::MutationEvent event = new(std::nothrow) MutationEventImp;
-                event.initMutationEvent(u"DOMAttrModified",
-                                        true, false, attr, prevValue, value, n, events::MutationEvent::MODIFICATION);
-                this->dispatchEvent(event);
-            }
-            return;
+    if (InlineAttr* attr = findAttribute(n)) {
+        std::u16string prevValue = attr->getValue();
+        if (prevValue != value) {
+            attr->setValue(value);
+            Attr node = attr->attr;
+            if (n == u"id")
+                updateElementId(prevValue, value);
+            else if (n == u"class")
+                updateDOMVersion();
+            dispatchAttrModified(node, prevValue, value, n, events::MutationEvent::MODIFICATION);
         }
+        return;
     }
-    if (Attr attr = new(std::nothrow) AttrImp(Nullable<std::u16string>(), Nullable<std::u16string>(), n, value)) {
-        attributes.push_back(attr);
-        events::MutationEvent event = new(std::nothrow) MutationEventImp;
-        event.initMutationEvent(u"DOMAttrModified",
-                                true, false, attr, u"", value, n, events::MutationEvent::ADDITION);
-        this->dispatchEvent(event);
-    }
+    attributes.emplace_back(n, std::u16string(), value);
+    if (n == u"id")
+        updateElementId(Nullable<std::u16string>(), value);
+    else if (n == u"class")
+        updateDOMVersion();
+    dispatchAttrModified(0, u"", value, n, events::MutationEvent::ADDITION);
 }
 
 void ElementImp::setAttributeNS(const Nullable<std::u16string>& namespaceURI, const std::u16string& name, const std::u16string& value)
@@ -285,29 +364,30 @@ void ElementImp::setAttributeNS(const Nullable<std::u16string>& namespaceURI, co
     if ((name == u"xmlns" || prefix.hasValue() && prefix.value() == u"xmlns") && namespaceURI != u"http://www.w3.org/2000/xmlns")
         throw DOMException{DOMException::NAMESPACE_ERR};
  */
-    for (auto i = attributes.begin(); i != attributes.end(); ++i) {
-        Attr attr = *i;
-        if (static_cast<std::u16string>(attr.getNamespaceURI()) == static_cast<std::u16string>(namespaceURI) && attr.getLocalName() == localName) {
-            std::u16string prevValue = attr.getValue();
-            if (prevValue != value) {
-                attr.setValue(value);
-                // TODO: set prefix, too.
-
-                events::MutationEvent event = new(std::nothrow) MutationEventImp;
-                event.initMutationEvent(u"DOMAttrModified",
-                                        true, false, attr, prevValue, value, localName, events::MutationEvent::MODIFICATION);
-                dispatchEvent(event);
-            }
-            return;
+    bool isId = (localName == u"id");
+    Nullable<std::u16string> prevId;
+    if (isId)
+        prevId = getAttribute(u"id");
+    if (InlineAttr* attr = findAttributeNS(namespaceURI, localName)) {
+        std::u16string prevValue = attr->getValue();
+        if (prevValue != value) {
+            attr->setValue(value);
+            // TODO: set prefix, too.
+            Attr node = attr->attr;
+            if (isId)
+                updateElementId(prevId, getAttribute(u"id"));
+            else if (localName == u"class")
+                updateDOMVersion();
+            dispatchAttrModified(node, prevValue, value, localName, events::MutationEvent::MODIFICATION);
         }
+        return;
     }
-    if (Attr attr = new(std::nothrow) AttrImp(namespaceURI, prefix, localName, value)) {
-        attributes.push_back(attr);
-        events::MutationEvent event = new(std::nothrow) MutationEventImp;
-        event.initMutationEvent(u"DOMAttrModified",
-                                true, false, attr, u"", value, localName, events::MutationEvent::ADDITION);
-        dispatchEvent(event);
-    }
+    attributes.emplace_back(name, static_cast<std::u16string>(namespaceURI), value);
+    if (isId)
+        updateElementId(prevId, getAttribute(u"id"));
+    else if (localName == u"class")
+        updateDOMVersion();
+    dispatchAttrModified(0, u"", value, localName, events::MutationEvent::ADDITION);
 }
 
 void ElementImp::removeAttribute(const std::u16string& name)
@@ -315,14 +395,18 @@ void ElementImp::removeAttribute(const std::u16string& name)
     // TODO: If the context node is in the HTML namespace and its ownerDocument is an HTML document
     std::u16string n(name);
         toLower(n);
-    for (auto i = attributes.begin(); i != attributes.end();) {
-        Attr attr = *i;
-        if (attr.getName() == n) {
-            events::MutationEvent event = new(std::nothrow) MutationEventImp;
-            event.initMutationEvent(u"DOMAttrModified",
-                                    true, false, attr, attr.getValue(), u"", n, events::MutationEvent::REMOVAL);
-            this->dispatchEvent(event);
-            i = attributes.erase(i);
+    // Note a mutation event listener can modify the attributes.
+    for (size_t i = 0; i < attributes.size();) {
+        if (attributes[i].name == n) {
+            Attr node = attributes[i].attr;
+            std::u16string prevValue = attributes[i].getValue();
+            attributes[i].detach();
+            attributes.erase(attributes.begin() + i);
+            if (n == u"id")
+                updateElementId(prevValue, Nullable<std::u16string>());
+            else if (n == u"class")
+                updateDOMVersion();
+            dispatchAttrModified(node, prevValue, u"", n, events::MutationEvent::REMOVAL);
         } else
             ++i;
     }
@@ -330,17 +414,21 @@ void ElementImp::removeAttribute(const std::u16string& name)
 
 void ElementImp::removeAttributeNS(const Nullable<std::u16string>& namespaceURI, const std::u16string& localName)
 {
-    for (auto i = attributes.begin(); i != attributes.end();) {
-        Attr attr = *i;
-        if (static_cast<std::u16string>(attr.getNamespaceURI()) == static_cast<std::u16string>(namespaceURI) && attr.getLocalName() == localName) {
-            events::MutationEvent event = new(std::nothrow) MutationEventImp;
-            event.initMutationEvent(u"DOMAttrModified",
-                                    true, false, attr, attr.getValue(), u"", localName, events::MutationEvent::REMOVAL);
-            this->dispatchEvent(event);
-            i = attributes.erase(i);
-        } else
-            ++i;
+    bool isId = (localName == u"id");
+    Nullable<std::u16string> prevId;
+    if (isId)
+        prevId = getAttribute(u"id");
+    while (InlineAttr* attr = findAttributeNS(namespaceURI, localName)) {
+        Attr node = attr->attr;
+        std::u16string prevValue = attr->getValue();
+        attr->detach();
+        attributes.erase(attributes.begin() + (attr - &attributes.front()));
+        dispatchAttrModified(node, prevValue, u"", localName, events::MutationEvent::REMOVAL);
     }
+    if (isId)
+        updateElementId(prevId, getAttribute(u"id"));
+    else if (localName == u"class")
+        updateDOMVersion();
 }
 
 bool ElementImp::hasAttribute(const std::u16string& name)
@@ -348,22 +436,12 @@ bool ElementImp::hasAttribute(const std::u16string& name)
     // TODO: If the context node is in the HTML namespace and its ownerDocument is an HTML document
     std::u16string n(name);
         toLower(n);
-    for (auto i = attributes.begin(); i != attributes.end(); ++i) {
-        Attr attr = *i;
-        if (attr.getName() == n)
-            return true;
-    }
-    return false;
+    return findAttribute(n);
 }
 
 bool ElementImp::hasAttributeNS(const Nullable<std::u16string>& namespaceURI, const std::u16string& localName)
 {
-    for (auto i = attributes.begin(); i != attributes.end(); ++i) {
-        Attr attr = *i;
-        if (static_cast<std::u16string>(attr.getNamespaceURI()) == static_cast<std::u16string>(namespaceURI) && attr.getLocalName() == localName)
-            return true;
-    }
-    return false;
+    return findAttributeNS(namespaceURI, localName);
 }
 
 html::HTMLCollection ElementImp::getChildren()
@@ -372,28 +450,11 @@ html::HTMLCollection ElementImp::getChildren()
     return static_cast<Object*>(0);
 }
 
-HTMLCollectionImp* ElementImp::getElementsByTagName(ElementImp* element, const std::u16string& localName)
-{
-    HTMLCollectionImp* list = new(std::nothrow) HTMLCollectionImp;
-    if (!list)
-        return 0;
-
-    if (localName == u"*") {
-        for (ElementImp* e = element; e; e = e->getNextElement())
-            list->addItem(e);
-    } else {
-        // TODO: Support non HTML document
-        for (ElementImp* e = element; e; e = e->getNextElement()) {
-            if (e->getLocalName() == localName)
-                list->addItem(e);
-        }
-    }
-    return list;
-}
-
 html::HTMLCollection ElementImp::getElementsByTagName(const std::u16string& localName)
 {
-    return getElementsByTagName(this, localName);
+    if (DocumentImp* document = getOwnerDocumentImp())
+        return document->getLiveCollection(this, HTMLLiveCollectionImp::TagName, localName);
+    return new(std::nothrow) HTMLLiveCollectionImp(this, 0, HTMLLiveCollectionImp::TagName, localName);
 }
 
 html::HTMLCollection ElementImp::getElementsByTagNameNS(const Nullable<std::u16string>& namespaceURI, const std::u16string& localName)
@@ -402,34 +463,11 @@ html::HTMLCollection ElementImp::getElementsByTagNameNS(const Nullable<std::u16s
     return static_cast<Object*>(0);
 }
 
-HTMLCollectionImp* ElementImp::getElementsByClassName(ElementImp* element, const std::u16string& classNames)
-{
-    HTMLCollectionImp* list = new(std::nothrow) HTMLCollectionImp;
-    if (!list)
-        return 0;
-
-    std::vector<std::u16string> classes;
-    boost::algorithm::split(classes, classNames, isSpace);
-    for (ElementImp* e = element; e; e = e->getNextElement()) {
-        std::u16string c = e->getClassName();
-        std::vector<std::u16string> v;
-        boost::algorithm::split(v, c, isSpace);
-        bool notFound = false;
-        for (auto i = classes.begin(); i != classes.end(); ++i) {
-            if (std::find(v.begin(), v.end(), *i) == v.end()) {
-                notFound = true;
-                break;
-            }
-        }
-        if (!notFound)
-            list->addItem(e);
-    }
-    return list;
-}
-
 html::HTMLCollection ElementImp::getElementsByClassName(const std::u16string& classNames)
 {
-    return getElementsByClassName(this, classNames);
+    if (DocumentImp* document = getOwnerDocumentImp())
+        return document->getLiveCollection(this, HTMLLiveCollectionImp::ClassName, classNames);
+    return new(std::nothrow) HTMLLiveCollectionImp(this, 0, HTMLLiveCollectionImp::ClassName, classNames);
 }
 
 Element ElementImp::getFirstElementChild()
@@ -618,6 +656,23 @@ Element ElementImp::querySelector(CSSSelectorsGroup* selectorsGroup, ViewCSSImp*
     return 0;
 }
 
+// Returns the only element in the document tree that has the ID required
+// by selectorsGroup, and sets count to the number of such elements; count
+// is set to -1 if the document cannot tell.
+ElementImp* ElementImp::findElementId(CSSSelectorsGroup* selectorsGroup, size_t& count)
+{
+    count = static_cast<size_t>(-1);
+    const std::u16string* id = selectorsGroup->getID();
+    if (!id)
+        return 0;
+    DocumentImp* document = getDocumentTree();
+    if (!document)
+        return 0;
+    ElementImp* e;
+    count = document->findElementId(*id, e);
+    return e;
+}
+
 Element ElementImp::querySelector(const std::u16string& selectors)
 {
     CSSParser parser;
@@ -630,6 +685,13 @@ Element ElementImp::querySelector(const std::u16string& selectors)
     WindowImp* window = getOwnerDocumentImp()->getDefaultWindow();
     if (!window)
         return 0;
+    size_t count;
+    ElementImp* e = findElementId(selectorsGroup.get(), count);
+    if (count <= 1) {
+        if (e && (e == this || isAncestorOf(e)) && selectorsGroup->evaluate(e, window->getView()))
+            return e;
+        return 0;
+    }
     return querySelector(selectorsGroup.get(), window->getView());
 }
 
@@ -659,6 +721,13 @@ NodeList ElementImp::querySelectorAll(const std::u16string& selectors)
     WindowImp* window = getOwnerDocumentImp()->getDefaultWindow();
     if (!window)
         return nodeList;
+    size_t count;
+    ElementImp* e = findElementId(selectorsGroup.get(), count);
+    if (count <= 1) {
+        if (e && (e == this || isAncestorOf(e)) && selectorsGroup->evaluate(e, window->getView()))
+            nodeList->addItem(e);
+        return nodeList;
+    }
     querySelectorAll(nodeList, selectorsGroup.get(), window->getView());
     return nodeList;
 }
@@ -706,10 +775,15 @@ ElementImp::ElementImp(ElementImp* org, bool deep) :
     namespaceURI = org->namespaceURI;
     prefix = org->prefix;
     localName = org->localName;
-    for (auto i = org->attributes.begin(); i != org->attributes.end(); ++i) {
-        if (Attr attr = new(std::nothrow) AttrImp(*dynamic_cast<AttrImp*>((*i).self())))
-            attributes.push_back(attr);
-    }
+    attributes.reserve(org->attributes.size());
+    for (auto i = org->attributes.begin(); i != org->attributes.end(); ++i)
+        attributes.emplace_back(i->name, i->namespaceURI, i->getValue());
+}
+
+ElementImp::~ElementImp()
+{
+    for (auto i = attributes.begin(); i != attributes.end(); ++i)
+        i->detach();
 }
 
 }}}}  // org::w3c::dom::bootstrap
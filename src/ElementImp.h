@@ -36,13 +36,16 @@
 #include <org/w3c/dom/xbl2/XBLImplementationList.h>
 
 #include <deque>
+#include <vector>
 
+#include "Atom.h"
 #include "NodeImp.h"
 
+class Attribute;
+
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
 class CSSSelectorsGroup;
-class HTMLCollectionImp;
 class NodeListImp;
 class ViewCSSImp;
 
@@ -51,21 +54,59 @@ class ElementImp : public ObjectMixin<ElementImp, NodeImp>
     friend class AttrArray;
     friend class ViewCSSImp;
 
-    std::deque<Attr> attributes;
+    // An attribute stored inline in the element. The Attr node is created
+    // only when it is asked for, and then its value is kept in sync. The
+    // names are kept as plain strings; an element has only a few attributes
+    // and comparing short strings is cheaper than interning every name.
+    struct InlineAttr
+    {
+        std::u16string name;  // qualified name
+        std::u16string namespaceURI;
+        std::u16string value;
+        Attr attr;
+
+        InlineAttr(const std::u16string& name, const std::u16string& namespaceURI, const std::u16string& value) :
+            name(name),
+            namespaceURI(namespaceURI),
+            value(value),
+            attr(0)
+        {}
+        const std::u16string& getValue() const {
+            return value;
+        }
+        void setValue(const std::u16string& value);
+        void detach();
+        std::u16string getLocalName() const;
+    };
+
+    std::vector<InlineAttr> attributes;
     std::u16string namespaceURI;
     std::u16string prefix;
-    std::u16string localName;
+    Atom localName;
 
     Element querySelector(CSSSelectorsGroup* selectorsGroup, ViewCSSImp* view);
     void querySelectorAll(NodeListImp* nodeList, CSSSelectorsGroup* selectorsGroup, ViewCSSImp* view);
+    ElementImp* findElementId(CSSSelectorsGroup* selectorsGroup, size_t& count);
+
+    void updateElementId(const Nullable<std::u16string>& prevId, const Nullable<std::u16string>& id);
+
+    InlineAttr* findAttribute(const std::u16string& name);
+    InlineAttr* findAttributeNS(const Nullable<std::u16string>& namespaceURI, const std::u16string& localName);
+    Attr getAttr(InlineAttr& attribute);
+    void dispatchAttrModified(const Attr& attr, const std::u16string& prevValue, const std::u16string& newValue, const std::u16string& name, unsigned short change);
 
 public:
     ElementImp(DocumentImp* ownerDocument, const std::u16string& localName, const std::u16string& namespaceURI, const std::u16string& prefix = u"");
     ElementImp(ElementImp* org, bool deep);
+    ~ElementImp();
 
-    void setAttributes(const std::deque<Attr>& attributes);
+    void setAttributes(const std::vector<Attribute>& list);
     ElementImp* getNextElement(ElementImp* root = 0);
 
+    Atom getLocalNameAtom() const {
+        return localName;
+    }
+
     // notify() is called when conditions that are not handled by DOM events
     // but still needed be processed occur; e.g., the element is popped off
     // the stack of open elements of an HTML parser.
@@ -150,9 +191,6 @@ public:
     {
         return Element::getMetaData();
     }
-
-    static HTMLCollectionImp* getElementsByTagName(ElementImp* element, const std::u16string& localName);
-    static HTMLCollectionImp* getElementsByClassName(ElementImp* element, const std::u16string& classNames);
 };
 
 }}}}  // org::w3c::dom::bootstrap
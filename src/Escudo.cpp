@@ -72,6 +72,7 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
     HttpRequest::setCachePath(profile.createPath("cache"));
+    HttpCacheManager::getInstance().setPersistent(profile.createPath("cache"));
 
     init(&argc, argv);
     initLogLevel(&argc, argv, 0);
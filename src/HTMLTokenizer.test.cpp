@@ -32,7 +32,7 @@ bool emit(const Token& token, std::ostream& output)
     static std::u16string characters;
     bool eof = false;
 
-    if (characterMode && token.getType() != Token::Type::Character) {
+    if (characterMode && token.getType() != Token::Type::Character && token.getType() != Token::Type::Characters) {
         output << separator << "[\"Character\",\"" << espaceString(characters) << "\"]";
         separator = ",";
         characterMode = false;
@@ -80,6 +80,10 @@ bool emit(const Token& token, std::ostream& output)
         characterMode = true;
         characters += token.getChar();
         break;
+    case Token::Type::Characters:
+        characterMode = true;
+        characters += token.getName();
+        break;
     case Token::Type::EndOfFile:
         eof = true;
         break;
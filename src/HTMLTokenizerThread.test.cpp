@@ -0,0 +1,129 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "html/HTMLInputStream.h"
+#include "html/HTMLTokenizer.h"
+#include "html/HTMLTokenizerThread.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include "utf.h"
+
+namespace {
+
+const unsigned Timeout = 1000;  // in milliseconds
+
+// Takes the tokens from the worker up to the end-of-file token, and writes
+// them out in a compact form. At the end tag of a script, text is
+// inserted into the input as document.write() does.
+std::string tokenize(HTMLTokenizer& tokenizer, HTMLTokenizerThread& thread, const std::u16string& written)
+{
+    std::ostringstream result;
+    std::u16string characters;
+    auto start = std::chrono::steady_clock::now();
+    for (;;) {
+        if (!thread.isReady()) {
+            if (std::chrono::milliseconds(Timeout) < std::chrono::steady_clock::now() - start) {
+                result << "(timeout)";
+                break;
+            }
+            thread.wait(10);
+            continue;
+        }
+        Token token = thread.getToken();
+        if (token.getType() == Token::Type::Character) {
+            characters += static_cast<char16_t>(token.getChar());
+            continue;
+        }
+        if (token.getType() == Token::Type::Characters) {
+            characters += token.getName();
+            continue;
+        }
+        if (!characters.empty()) {
+            result << '"' << characters << "\" ";
+            characters.clear();
+        }
+        switch (token.getType()) {
+        case Token::Type::StartTag:
+            result << '<' << token.getName() << "> ";
+            break;
+        case Token::Type::EndTag:
+            result << "</" << token.getName() << "> ";
+            if (token.getName() == u"script" && !written.empty())
+                tokenizer.insertString(written);
+            break;
+        case Token::Type::EndOfFile:
+            result << "EOF";
+            return result.str();
+        default:
+            break;
+        }
+    }
+    return result.str();
+}
+
+int test(const std::string& description, const std::string& input, unsigned long long available, bool complete,
+         const std::u16string& written, const std::string& expected)
+{
+    std::istringstream stream(input);
+    HTMLInputStream htmlInputStream(stream, "utf-8");
+    HTMLTokenizer tokenizer(&htmlInputStream);
+    std::string output;
+    {
+        HTMLTokenizerThread thread(&tokenizer, &htmlInputStream, available, complete);
+        if (!complete) {
+            // The rest arrives after the worker has started.
+            thread.update(input.length(), true);
+        }
+        output = tokenize(tokenizer, thread, written);
+    }
+    std::cout << "description: " << description << '\n';
+    std::cout << "input: " << input << '\n';
+    std::cout << "expected: " << expected << '\n';
+    if (output == expected) {
+        std::cout << "PASS\n";
+        return EXIT_SUCCESS;
+    }
+    std::cout << "FAIL: " << output << '\n';
+    return EXIT_FAILURE;
+}
+
+}  // namespace
+
+int main()
+{
+    int rc = EXIT_SUCCESS;
+
+    // The whole document is available before the worker starts, e.g., from
+    // the cache or a local file.
+    std::string small("<p>hello</p>");
+    rc |= test("complete document", small, small.length(), true, u"",
+               "<p> \"hello\" </p> EOF");
+
+    std::string partial("<p>hello</p><p>world</p>");
+    rc |= test("updated document", partial, 5, false, u"",
+               "<p> \"hello\" </p> <p> \"world\" </p> EOF");
+
+    // The worker stops at </script> until the main thread has inserted
+    // the text.
+    std::string script("<p>a</script>tail");
+    rc |= test("document.write at a synchronization point", script, script.length(), true, u"<b>written</b>",
+               "<p> \"a\" </script> <b> \"written\" </b> \"tail\" EOF");
+
+    return rc;
+}
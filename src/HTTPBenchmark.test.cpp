@@ -0,0 +1,202 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// HTTPBenchmark.test [count [size]]
+//
+// Sends count concurrent requests for each scenario to a local test server
+// and reports the throughput, the latency, the number of the content octets
+// copied out by the client, and the number of the body octets sent by the
+// server.
+
+#include "http/HTTPConnection.h"
+#include "http/HTTPContentStream.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <boost/bind.hpp>
+
+#include "Test.httpd.h"
+#include "Test.util.h"
+#include "utf.h"
+
+using namespace org::w3c::dom::bootstrap;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Sample
+{
+    HttpRequest* request;
+    Clock::time_point start;
+    Clock::time_point end;
+    unsigned* remaining;
+};
+
+void handleComplete(Sample* sample)
+{
+    sample->end = Clock::now();
+    --*sample->remaining;
+}
+
+double getMilliseconds(Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / 1000.0;
+}
+
+std::string deflate(const std::string& data)
+{
+    uLongf length = compressBound(data.length());
+    std::string compressed(length, '\0');
+    if (compress2(reinterpret_cast<Bytef*>(&compressed[0]), &length,
+                  reinterpret_cast<const Bytef*>(data.c_str()), data.length(), Z_DEFAULT_COMPRESSION) != Z_OK)
+        return "";
+    compressed.resize(length);
+    return compressed;
+}
+
+// Reads the content the way a consumer does, and returns the number of the
+// octets copied out.
+unsigned long long copyContent(HttpRequest& request)
+{
+    HttpContentStream stream(request);
+    char buffer[16384];
+    unsigned long long count = 0;
+    while (stream) {
+        stream.read(buffer, sizeof buffer);
+        count += stream.gcount();
+    }
+    return count;
+}
+
+// Returns the number of the failed requests. A request is failed unless size
+// octets, i.e., the requested resource, can be copied out of it.
+int run(TestHttpServer& server, const char* name, const std::string& path, bool unique, unsigned count, size_t size)
+{
+    HttpConnectionManager& manager(HttpConnectionManager::getInstance());
+    HttpCacheManager& cache(HttpCacheManager::getInstance());
+    unsigned long long hitCount = cache.getHitCount();
+    unsigned long long requestCount = server.getRequestCount();
+    unsigned long long connectionCount = server.getConnectionCount();
+    unsigned long long octetCount = server.getOctetCount();
+
+    std::vector<Sample> samples(count);
+    unsigned remaining = count;
+    Clock::time_point start = Clock::now();
+    for (unsigned i = 0; i < count; ++i) {
+        Sample& sample(samples[i]);
+        std::string url = server.getURL(path);
+        if (unique)
+            url += "?" + std::to_string(i);  // not to be coalesced by the cache
+        sample.request = new HttpRequest;
+        sample.request->open(u"GET", utfconv(url));
+        sample.request->setHandler(boost::bind(handleComplete, &sample));
+        sample.remaining = &remaining;
+        sample.start = Clock::now();
+        sample.request->send();
+    }
+    while (remaining) {
+        manager.poll();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    Clock::duration elapsed = Clock::now() - start;
+
+    int errors = 0;
+    unsigned long long copied = 0;
+    std::vector<double> latencies;
+    for (auto i = samples.begin(); i != samples.end(); ++i) {
+        unsigned long long octets = copyContent(*i->request);
+        if (i->request->getError() || octets != size)
+            ++errors;
+        copied += octets;
+        latencies.push_back(getMilliseconds(i->end - i->start));
+        delete i->request;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double seconds = getMilliseconds(elapsed) / 1000.0;
+    printf("%-12s %8.1f req/s  p50 %8.2f ms  p99 %8.2f ms  %10llu copied  %10llu sent  %4llu requests  %4llu connections  %4llu hits  %d errors\n",
+           name, count / seconds,
+           latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100],
+           copied, server.getOctetCount() - octetCount,
+           server.getRequestCount() - requestCount, server.getConnectionCount() - connectionCount,
+           cache.getHitCount() - hitCount, errors);
+    return errors;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    initLogLevel(&argc, argv, 0);
+
+    unsigned count = (2 <= argc) ? strtoul(argv[1], 0, 10) : 500;
+    size_t size = (3 <= argc) ? strtoul(argv[2], 0, 10) : 16 * 1024;
+    if (count == 0)
+        return 1;
+
+    TestHttpServer server;
+    if (!server.start()) {
+        std::cerr << "could not start the test server\n";
+        return 1;
+    }
+    std::thread httpService(std::ref(HttpConnectionManager::getInstance()));
+
+    std::string body;
+    for (size_t i = 0; i < size; ++i)
+        body += "0123456789abcdef\n"[i % 17];
+
+    TestHttpServer::Resource resource(body);
+    resource.headers = "Cache-Control: no-store\r\n";
+    server.setResource("/identity", resource);
+
+    TestHttpServer::Resource chunked(resource);
+    chunked.chunkSize = 4096;
+    server.setResource("/chunked", chunked);
+
+    TestHttpServer::Resource deflated(resource);
+    deflated.body = deflate(body);
+    deflated.headers += "Content-Encoding: deflate\r\n";
+    server.setResource("/deflate", deflated);
+
+    TestHttpServer::Resource slow(resource);
+    slow.latency = 20;
+    server.setResource("/latency", slow);
+
+    TestHttpServer::Resource cached(body);
+    cached.etag = "\"benchmark\"";
+    cached.headers = "Cache-Control: max-age=3600\r\n";
+    server.setResource("/cached", cached);
+
+    int errors = 0;
+    errors += run(server, "identity", "/identity", true, count, size);
+    errors += run(server, "chunked", "/chunked", true, count, size);
+    errors += run(server, "deflate", "/deflate", true, count, size);
+    errors += run(server, "latency", "/latency", true, count, size);
+    errors += run(server, "cached", "/cached", false, count, size);
+    server.setKeepAlive(false);
+    errors += run(server, "close", "/identity", true, count, size);
+
+    HttpConnectionManager::getInstance().stop();
+    httpService.join();
+    server.stop();
+    return errors ? 1 : 0;
+}
@@ -17,10 +17,13 @@
 #include "http/HTTPHeader.h"
 #include "http/HTTPResponseMessage.h"
 #include "http/HTTPRequestMessage.h"
+#include "http/HTTPUtil.h"
 
 #include <string.h>
 #include <iostream>
 
+#include "Test.util.h"
+
 using namespace org::w3c::dom::bootstrap;
 
 const char* message =
@@ -76,6 +79,44 @@ const char* response5 =
     "Cache-Control: no-store, no-cache\r\n"
     "\r\n";
 
+const char* response6 =
+    "HTTP/1.1 204 No Content\r\n"
+    "\r\n";
+
+const char* fields =
+    "content-type: text/html\r\n"
+    "X-Custom: one\r\n"
+    "Cache-Control: no-cache\r\n"
+    "x-custom: two\r\n"
+    "CACHE-CONTROL: max-age=60\r\n"
+    "\r\n";
+
+const char* fresh =
+    "HTTP/1.1 200 OK\r\n"
+    "Date: Wed, 15 Nov 1995 06:25:24 GMT\r\n"
+    "Expires: Wed, 15 Nov 1995 07:25:24 GMT\r\n"
+    "Last-Modified: Wed, 15 Nov 1995 04:58:08 GMT\r\n"
+    "Age: 30\r\n"
+    "Cache-Control: max-age=600\r\n"
+    "\r\n";
+
+const char* expiring =
+    "HTTP/1.1 200 OK\r\n"
+    "Date: Wed, 15 Nov 1995 06:25:24 GMT\r\n"
+    "Expires: Wed, 15 Nov 1995 07:25:24 GMT\r\n"
+    "Last-Modified: Wed, 15 Nov 1995 04:58:08 GMT\r\n"
+    "\r\n";
+
+const char* modified =
+    "HTTP/1.1 200 OK\r\n"
+    "Date: Wed, 15 Nov 1995 06:25:24 GMT\r\n"
+    "Last-Modified: Wed, 15 Nov 1995 04:58:08 GMT\r\n"
+    "\r\n";
+
+const long long DateValue = 816416724;          // Wed, 15 Nov 1995 06:25:24 GMT
+const long long ExpiresValue = 816420324;       // Wed, 15 Nov 1995 07:25:24 GMT
+const long long LastModifiedValue = 816411488;  // Wed, 15 Nov 1995 04:58:08 GMT
+
 int testHttpHeaderList()
 {
     HttpHeaderList list;
@@ -100,16 +141,112 @@ int testHttpHeaderList()
     return 0;
 }
 
+// Tests the lookup by the IDs of the well-known fields and by the names of
+// the other fields, and how a repeated field is stored.
+int testHttpHeaderIDs()
+{
+    int rc = 0;
+    rc |= checkResult("known ID", HttpHeader::getID("Content-Length") == HttpHeader::ContentLength &&
+                                  HttpHeader::getID("content-length") == HttpHeader::ContentLength &&
+                                  HttpHeader::getID("TE") == HttpHeader::TE &&
+                                  strcmp(HttpHeader::getName(HttpHeader::IfNoneMatch), "If-None-Match") == 0);
+    rc |= checkResult("unknown ID", HttpHeader::getID("X-Custom") == HttpHeader::Other &&
+                                    HttpHeader::getID("Content-Lengths") == HttpHeader::Other &&
+                                    HttpHeader::getID("") == HttpHeader::Other);
+
+    HttpHeaderList list;
+    list.parse(fields, fields + strlen(fields));
+    std::cout << list.toString() << '\n';
+    std::string value;
+    const std::string* known = list.find(HttpHeader::ContentType);
+    rc |= checkResult("known field", known && *known == "text/html" &&
+                                     list.get("Content-Type", value) && value == "text/html" &&
+                                     !list.find(HttpHeader::ContentLength));
+    rc |= checkResult("unknown field", list.get("X-CUSTOM", value) && value == "two" &&
+                                       !list.get("X-Other", value));
+    rc |= checkResult("repeated field replaced", list.size() == 3 &&
+                                                 list.get(HttpHeader::CacheControl, value) && value == "max-age=60");
+
+    list.set("Cache-Control", "no-store", true);
+    list.set("Content-Type", "text/plain", true);
+    list.set("X-Custom", "three", true);
+    rc |= checkResult("repeated field merged", list.get(HttpHeader::CacheControl, value) && value == "max-age=60, no-store" &&
+                                               list.get(HttpHeader::ContentType, value) && value == "text/plain" &&
+                                               list.get("x-custom", value) && value == "three");
+
+    list.set("X-Custom", "");
+    list.erase("cache-control");
+    rc |= checkResult("removed field", list.size() == 1 && !list.get("X-Custom", value) &&
+                                       !list.find(HttpHeader::CacheControl) && list.find(HttpHeader::ContentType));
+    return rc;
+}
+
+// Tests the values used for the freshness of a cached response.
+int testFreshness()
+{
+    int rc = 0;
+    long long value;
+    unsigned maxAge;
+
+    HttpResponseMessage res;
+    res.parse(fresh, fresh + strlen(fresh));
+    rc |= checkResult("date value", res.getDateValue() == DateValue);
+    rc |= checkResult("expires value", res.getExpiresValue(value) && value == ExpiresValue);
+    rc |= checkResult("last-modified value", res.getLastModifiedValue(value) && value == LastModifiedValue);
+    rc |= checkResult("age value", res.getAgeValue() == 30);
+    rc |= checkResult("max-age value", res.getMaxAgeValue(maxAge) && maxAge == 600);
+    rc |= checkResult("max-age lifetime", res.getFreshnessLifetime(DateValue) == 600);
+    // max(max(0, now - date), age) + now - request time
+    rc |= checkResult("current age", res.getCurrentAge(DateValue + 10, DateValue + 5) == 35 &&
+                                     res.getCurrentAge(DateValue + 100, DateValue + 90) == 110);
+
+    HttpResponseMessage expires;
+    expires.parse(expiring, expiring + strlen(expiring));
+    rc |= checkResult("expires lifetime", !expires.getMaxAgeValue(maxAge) &&
+                                          expires.getFreshnessLifetime(DateValue) == ExpiresValue - DateValue);
+
+    HttpResponseMessage heuristic;
+    heuristic.parse(modified, modified + strlen(modified));
+    rc |= checkResult("heuristic lifetime", !heuristic.getExpiresValue(value) &&
+                                            heuristic.getFreshnessLifetime(DateValue) == (DateValue - LastModifiedValue) / 10);
+
+    HttpResponseMessage none;
+    none.parse(response6, response6 + strlen(response6));
+    rc |= checkResult("no freshness", none.getDateValue() == 0 && !none.getExpiresValue(value) &&
+                                      !none.getLastModifiedValue(value) && none.getAgeValue() == 0 &&
+                                      none.getFreshnessLifetime(DateValue) == 0);
+    return rc;
+}
+
 int testHttpResponseMessage(const char* response)
 {
     HttpResponseMessage res;
     res.parse(response, response + strlen(response));
     std::cout << res.toString() << ' ' << res.getContentLength() << ' ' << res.getDateValue() << ' ' <<
                  res.isNoCache() << ' ' << res.isNoStore() << ' ' <<
-                 res.getContentType() << ' ' << res.getContentCharset() << "\n\n";
+                 res.getContentType() << ' ' << res.getContentCharset() << "\n";
+    unsigned long long first, last, length;
+    if (res.getContentRange(first, last, length))
+        std::cout << first << '-' << last << '/' << length << ' ';
+    std::cout << '\'' << res.getRangeValidator() << "'\n\n";
     return 0;
 }
 
+// Scans the head as it would arrive one octet at a time.
+int testEndOfHead(const char* response)
+{
+    const char* end = response + strlen(response);
+    const char* next = response;
+    for (const char* p = response; p <= end; ++p) {
+        if (const char* eoh = http::findEndOfHead(next, p, next)) {
+            std::cout << "end of head: " << eoh - response << " of " << end - response << "\n\n";
+            return 0;
+        }
+    }
+    std::cout << "end of head: not found\n\n";
+    return 1;
+}
+
 int testHttpRequestMessage()
 {
     HttpRequestMessage req9;
@@ -131,11 +268,18 @@ int testHttpRequestMessage()
 
 int main(int argc, char* argv[])
 {
+    int rc = 0;
     testHttpHeaderList();
+    rc |= testHttpHeaderIDs();
+    rc |= testFreshness();
     testHttpRequestMessage();
     testHttpResponseMessage(response1);
     testHttpResponseMessage(response2);
     testHttpResponseMessage(response3);
     testHttpResponseMessage(response4);
     testHttpResponseMessage(response5);
+    testHttpResponseMessage(response6);
+    testEndOfHead(response3);
+    testEndOfHead(response6);
+    return rc;
 }
\ No newline at end of file
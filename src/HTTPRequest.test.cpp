@@ -20,8 +20,8 @@
 
 #include <iostream>
 #include <boost/version.hpp>
-#include <boost/iostreams/stream.hpp>
-#include <boost/iostreams/device/file_descriptor.hpp>
+
+#include "http/HTTPContentStream.h"
 
 #include "Test.util.h"
 #include "utf.h"
@@ -51,7 +51,7 @@ int test(std::u16string urlString)
 
     std::cerr << request.getResponseMessage().toString() << "----\n";
     std::cerr << request.getResponseMessage().getContentCharset() << "----\n";
-    boost::iostreams::stream<boost::iostreams::file_descriptor_source> stream(request.getContentDescriptor(), boost::iostreams::close_handle);
+    HttpContentStream stream(request);
     while (stream) {
         char c = stream.get();
         if (stream.good())
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Tests the content interrupted by the server is resumed with a range
+// request, or restarted if the server does not support ranges.
+
+#include "http/HTTPConnection.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <boost/bind.hpp>
+
+#include "Test.httpd.h"
+#include "Test.util.h"
+#include "utf.h"
+
+using namespace org::w3c::dom::bootstrap;
+
+namespace {
+
+const unsigned Timeout = 5000;  // in milliseconds
+
+void handleComplete(bool* done)
+{
+    *done = true;
+}
+
+int test(TestHttpServer& server, const char* description, const std::string& path, const std::string& expected,
+         unsigned long long requests, unsigned long long partials)
+{
+    HttpConnectionManager& manager(HttpConnectionManager::getInstance());
+    unsigned long long requestCount = server.getRequestCount();
+    unsigned long long partialCount = server.getPartialCount();
+
+    bool done = false;
+    HttpRequest request;
+    request.open(u"GET", utfconv(server.getURL(path)));
+    request.setHandler(boost::bind(handleComplete, &done));
+    request.send();
+    auto start = std::chrono::steady_clock::now();
+    while (!done && std::chrono::steady_clock::now() - start < std::chrono::milliseconds(Timeout)) {
+        manager.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::cout << "description: " << description << '\n';
+    if (!done) {
+        std::cout << "FAIL: timeout\n";
+        return 1;
+    }
+    if (request.getError()) {
+        std::cout << "FAIL: error " << request.getError() << '\n';
+        return 1;
+    }
+    if (request.getStatus() != 200) {
+        std::cout << "FAIL: status " << request.getStatus() << '\n';
+        return 1;
+    }
+    HttpContentSpan span = request.getContentSpan();
+    std::string content(span.begin(), span.size());
+    if (content != expected) {
+        std::cout << "FAIL: " << content.length() << " octets received; " << expected.length() << " expected\n";
+        return 1;
+    }
+    if (server.getRequestCount() - requestCount != requests || server.getPartialCount() - partialCount != partials) {
+        std::cout << "FAIL: " << server.getRequestCount() - requestCount << " requests, " <<
+                     server.getPartialCount() - partialCount << " partial responses\n";
+        return 1;
+    }
+    std::cout << "PASS\n";
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    initLogLevel(&argc, argv, 0);
+
+    TestHttpServer server;
+    if (!server.start()) {
+        std::cerr << "could not start the test server\n";
+        return 1;
+    }
+    std::thread httpService(std::ref(HttpConnectionManager::getInstance()));
+
+    std::string body;
+    for (size_t i = 0; i < 64 * 1024; ++i)
+        body += "0123456789abcdef\n"[i % 17];
+
+    TestHttpServer::Resource resumed(body);
+    resumed.etag = "\"resume\"";
+    resumed.headers = "Cache-Control: no-store\r\n";
+    resumed.ranges = true;
+    resumed.truncate = 20000;
+    server.setResource("/resume", resumed);
+
+    TestHttpServer::Resource restarted(resumed);
+    restarted.ranges = false;
+    server.setResource("/restart", restarted);
+
+    int errors = 0;
+    errors += test(server, "206 Content-Range resumes the interrupted content", "/resume", body, 2, 1);
+    errors += test(server, "200 restarts the interrupted content", "/restart", body, 2, 0);
+
+    HttpConnectionManager::getInstance().stop();
+    httpService.join();
+    server.stop();
+    return errors ? 1 : 0;
+}
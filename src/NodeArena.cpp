@@ -0,0 +1,213 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NodeArena.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <iterator>
+#include <mutex>
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+namespace {
+
+struct FreeSlot
+{
+    FreeSlot* next;
+};
+
+// The header at the top of each chunk. An object larger than MaxSlotSize
+// gets a chunk-aligned block of its own, marked as Large.
+struct Chunk
+{
+    unsigned sizeClass;
+    unsigned used;          // the number of the slots in use
+    FreeSlot* freeList;
+    char* next;             // the next unused slot
+    Chunk* prev;            // in the list of the chunks with a free slot
+    Chunk* following;
+};
+
+const size_t ChunkSize = 64 * 1024;     // also the alignment of a chunk
+const size_t Granularity = 16;
+const size_t MaxSlotSize = 2048;
+const size_t HeaderSize = (sizeof(Chunk) + Granularity - 1) & ~(Granularity - 1);  // keeps the slots 16-byte aligned
+const unsigned Large = ~0u;
+
+struct SizeClass
+{
+    std::mutex mutex;
+    Chunk* available;       // the chunks with a free slot
+    Chunk* spare;           // an empty chunk kept for the next allocation
+};
+
+struct Arena
+{
+    SizeClass classes[MaxSlotSize / Granularity];
+    std::atomic<size_t> chunkCount;
+};
+
+Arena& getArena()
+{
+    static Arena arena;
+    return arena;
+}
+
+size_t getSlotSize(unsigned sizeClass)
+{
+    return (sizeClass + 1) * Granularity;
+}
+
+Chunk* allocateChunk(size_t size, unsigned sizeClass)
+{
+    void* block;
+    if (posix_memalign(&block, ChunkSize, size))
+        return 0;
+    ++getArena().chunkCount;
+    Chunk* chunk = static_cast<Chunk*>(block);
+    chunk->sizeClass = sizeClass;
+    return chunk;
+}
+
+void freeChunk(Chunk* chunk)
+{
+    --getArena().chunkCount;
+    free(chunk);
+}
+
+void resetChunk(Chunk* chunk)
+{
+    chunk->used = 0;
+    chunk->freeList = 0;
+    chunk->next = reinterpret_cast<char*>(chunk) + HeaderSize;
+}
+
+bool isFull(Chunk* chunk)
+{
+    return !chunk->freeList &&
+           static_cast<size_t>(reinterpret_cast<char*>(chunk) + ChunkSize - chunk->next) < getSlotSize(chunk->sizeClass);
+}
+
+void link(SizeClass& c, Chunk* chunk)
+{
+    chunk->prev = 0;
+    chunk->following = c.available;
+    if (c.available)
+        c.available->prev = chunk;
+    c.available = chunk;
+}
+
+void unlink(SizeClass& c, Chunk* chunk)
+{
+    if (chunk->prev)
+        chunk->prev->following = chunk->following;
+    else
+        c.available = chunk->following;
+    if (chunk->following)
+        chunk->following->prev = chunk->prev;
+    chunk->prev = chunk->following = 0;
+}
+
+}
+
+void* NodeArena::allocate(size_t size)
+{
+    if (size == 0)
+        size = 1;
+    if (MaxSlotSize < size) {
+        char* block = reinterpret_cast<char*>(allocateChunk(HeaderSize + size, Large));
+        return block ? block + HeaderSize : 0;
+    }
+
+    unsigned index = (size + Granularity - 1) / Granularity - 1;
+    SizeClass& c = getArena().classes[index];
+    std::lock_guard<std::mutex> lock(c.mutex);
+    Chunk* chunk = c.available;
+    if (!chunk) {
+        if (c.spare) {
+            chunk = c.spare;
+            c.spare = 0;
+        } else {
+            chunk = allocateChunk(ChunkSize, index);
+            if (!chunk)
+                return 0;
+            resetChunk(chunk);
+        }
+        link(c, chunk);
+    }
+    void* p;
+    if (FreeSlot* slot = chunk->freeList) {
+        chunk->freeList = slot->next;
+        p = slot;
+    } else {
+        p = chunk->next;
+        chunk->next += getSlotSize(index);
+    }
+    ++chunk->used;
+    if (isFull(chunk))
+        unlink(c, chunk);
+    return p;
+}
+
+void NodeArena::deallocate(void* p)
+{
+    if (!p)
+        return;
+    Chunk* chunk = reinterpret_cast<Chunk*>(reinterpret_cast<uintptr_t>(p) & ~(ChunkSize - 1));
+    if (chunk->sizeClass == Large) {
+        freeChunk(chunk);
+        return;
+    }
+    SizeClass& c = getArena().classes[chunk->sizeClass];
+    std::lock_guard<std::mutex> lock(c.mutex);
+    bool full = isFull(chunk);
+    FreeSlot* slot = static_cast<FreeSlot*>(p);
+    slot->next = chunk->freeList;
+    chunk->freeList = slot;
+    if (--chunk->used == 0) {
+        if (!full)
+            unlink(c, chunk);
+        if (c.spare)
+            freeChunk(chunk);
+        else {
+            resetChunk(chunk);
+            c.spare = chunk;
+        }
+    } else if (full)
+        link(c, chunk);
+}
+
+void NodeArena::release()
+{
+    Arena& arena = getArena();
+    for (auto i = std::begin(arena.classes); i != std::end(arena.classes); ++i) {
+        std::lock_guard<std::mutex> lock(i->mutex);
+        if (i->spare) {
+            freeChunk(i->spare);
+            i->spare = 0;
+        }
+    }
+}
+
+size_t NodeArena::getChunkCount()
+{
+    return getArena().chunkCount;
+}
+
+}}}}  // org::w3c::dom::bootstrap
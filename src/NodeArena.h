@@ -0,0 +1,48 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES_NODEARENA_H_INCLUDED
+#define ES_NODEARENA_H_INCLUDED
+
+#include <cstddef>
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+// NodeArena allocates the DOM nodes from 64 KiB chunks. Each chunk is
+// carved into slots of a single size class, so that the nodes created one
+// after another by the parser sit next to each other in memory. A freed
+// slot is kept in the free list of its chunk and reused for the next node
+// of that size. Each size class has a lock of its own. A chunk that has
+// become empty is returned to the system, except for one spare chunk per
+// size class, which is kept until release() is called.
+class NodeArena
+{
+public:
+    // Returns 0 if out of memory.
+    static void* allocate(size_t size);
+    static void deallocate(void* p);
+
+    // Returns the spare chunks to the system, e.g., once a document has
+    // been destroyed.
+    static void release();
+
+    // Returns the number of the chunks allocated from the system.
+    static size_t getChunkCount();
+};
+
+}}}}  // org::w3c::dom::bootstrap
+
+#endif  // ES_NODEARENA_H_INCLUDED
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NodeArena.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "Test.util.h"
+
+using namespace org::w3c::dom::bootstrap;
+
+namespace {
+
+int testReuse()
+{
+    void* p = NodeArena::allocate(40);
+    NodeArena::deallocate(p);
+    void* q = NodeArena::allocate(40);
+    bool reused = p == q;
+    bool aligned = (reinterpret_cast<uintptr_t>(q) % 16) == 0;
+    void* r = NodeArena::allocate(48);
+    bool distinct = r != q;
+    NodeArena::deallocate(q);
+    NodeArena::deallocate(r);
+    return checkResult("a freed slot is reused for the next node of its size", reused && aligned && distinct);
+}
+
+int testRelease()
+{
+    NodeArena::release();
+    size_t count = NodeArena::getChunkCount();
+    std::vector<void*> slots;
+    for (int i = 0; i < 10000; ++i)
+        slots.push_back(NodeArena::allocate(64));
+    bool grown = count + 2 <= NodeArena::getChunkCount();
+    for (auto i = slots.begin(); i != slots.end(); ++i)
+        NodeArena::deallocate(*i);
+    bool spared = NodeArena::getChunkCount() <= count + 1;
+    NodeArena::release();
+    return checkResult("empty chunks are returned to the system",
+                       grown && spared && NodeArena::getChunkCount() == count);
+}
+
+int testLarge()
+{
+    size_t count = NodeArena::getChunkCount();
+    void* p = NodeArena::allocate(4096);
+    bool allocated = p && NodeArena::getChunkCount() == count + 1;
+    NodeArena::deallocate(p);
+    return checkResult("a large node gets a chunk of its own", allocated && NodeArena::getChunkCount() == count);
+}
+
+int testDocument()
+{
+    std::string html("<!DOCTYPE html><html><body>");
+    for (int i = 0; i < 5000; ++i)
+        html += "<div class='c'><p id='p" + std::to_string(i) + "'>text <b>bold</b></p></div>";
+
+    loadDocument(html.c_str());  // warm up the objects kept for the process
+    NodeArena::release();
+    size_t count = NodeArena::getChunkCount();
+    loadDocument(html.c_str());
+    return checkResult("destroying a document returns its chunks", NodeArena::getChunkCount() == count);
+}
+
+}  // namespace
+
+int main()
+{
+    int rc = EXIT_SUCCESS;
+    rc |= testReuse();
+    rc |= testRelease();
+    rc |= testLarge();
+    rc |= testDocument();
+    return rc;
+}
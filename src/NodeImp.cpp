@@ -28,6 +28,11 @@ namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
 NodeImp* NodeImp::removeChild(NodeImp* item)
 {
+    if (0 < count_()) {  // Skip the index update from the destructor.
+        if (DocumentImp* document = getDocumentTree())
+            item->indexElementIds(document, false);
+        updateDOMVersion();
+    }
     NodeImp* next = item->nextSibling;
     NodeImp* prev = item->previousSibling;
     if (!next)
@@ -54,6 +59,9 @@ NodeImp* NodeImp::insertBefore(NodeImp* item, NodeImp* after)
         item->previousSibling->nextSibling = item;
     item->parentNode = this;
     ++childCount;
+    if (DocumentImp* document = getDocumentTree())
+        item->indexElementIds(document, true);
+    updateDOMVersion();
     return item;
 }
 
@@ -69,9 +77,41 @@ NodeImp* NodeImp::appendChild(NodeImp* item)
     lastChild = item;
     item->parentNode = this;
     ++childCount;
+    if (DocumentImp* document = getDocumentTree())
+        item->indexElementIds(document, true);
+    updateDOMVersion();
     return item;
 }
 
+void NodeImp::indexElementIds(DocumentImp* document, bool add)
+{
+    if (ElementImp* element = dynamic_cast<ElementImp*>(this)) {
+        Nullable<std::u16string> id = element->getAttribute(u"id");
+        if (id.hasValue()) {
+            if (add)
+                document->addElementId(id.value(), element);
+            else
+                document->removeElementId(id.value(), element);
+        }
+    }
+    for (NodeImp* child = firstChild; child; child = child->nextSibling)
+        child->indexElementIds(document, add);
+}
+
+void NodeImp::updateDOMVersion()
+{
+    if (DocumentImp* document = ownerDocument ? ownerDocument : dynamic_cast<DocumentImp*>(this))
+        document->updateDOMVersion();
+}
+
+DocumentImp* NodeImp::getDocumentTree()
+{
+    NodeImp* root = this;
+    while (root->parentNode)
+        root = root->parentNode;
+    return dynamic_cast<DocumentImp*>(root);
+}
+
 void NodeImp::setOwnerDocument(DocumentImp* document)
 {
     ownerDocument = document;
@@ -31,8 +31,10 @@
 #include <org/w3c/dom/NodeList.h>
 
 #include "EventTargetImp.h"
+#include "NodeArena.h"
 
 #include <list>
+#include <new>
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
@@ -44,6 +46,7 @@ class NodeImp : public ObjectMixin<NodeImp, EventTargetImp>
     friend class ElementImp;
     friend class EventTargetImp;
     friend class HTMLElementImp;  // for focus
+    friend class HTMLLiveCollectionImp;
 
     DocumentImp* ownerDocument;
     NodeImp* parentNode;
@@ -57,14 +60,37 @@ class NodeImp : public ObjectMixin<NodeImp, EventTargetImp>
     NodeImp* appendChild(NodeImp* item);
     NodeImp* insertBefore(NodeImp* item, NodeImp* after);
 
+    // Adds the IDs of the elements in this subtree to the document, or
+    // removes them from it.
+    void indexElementIds(DocumentImp* document, bool add);
+
 protected:
     std::u16string nodeName;
 
+    // Invalidates the live collections of the owner document.
+    void updateDOMVersion();
+
 public:
     NodeImp(DocumentImp* ownerDocument);
     NodeImp(NodeImp* org, bool deep);
     ~NodeImp();
 
+    // Nodes are allocated from NodeArena.
+    static void* operator new(size_t size) {
+        if (void* p = NodeArena::allocate(size))
+            return p;
+        throw std::bad_alloc();
+    }
+    static void* operator new(size_t size, const std::nothrow_t&) noexcept {
+        return NodeArena::allocate(size);
+    }
+    static void operator delete(void* p) {
+        NodeArena::deallocate(p);
+    }
+    static void operator delete(void* p, const std::nothrow_t&) {
+        NodeArena::deallocate(p);
+    }
+
     // Returns true if this is an ancestor of the node
     bool isAncestorOf(NodeImp* node) {
         for (NodeImp* parent = node->parentNode; parent; parent = parent->parentNode) {
@@ -77,6 +103,8 @@ public:
     DocumentImp* getOwnerDocumentImp() const {
         return ownerDocument;
     }
+    // Returns the document if this node is in a document tree, or 0 otherwise.
+    DocumentImp* getDocumentTree();
     void setOwnerDocument(DocumentImp* document);
 
     unsigned int getChildCount() const {
@@ -0,0 +1,281 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Test.httpd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include <algorithm>
+#include <sstream>
+#include <boost/bind.hpp>
+
+namespace {
+
+// Returns the value of the specified header field in the request head.
+std::string getHeader(const std::string& head, const char* name)
+{
+    size_t length = strlen(name);
+    for (size_t pos = head.find('\n'); pos != std::string::npos; pos = head.find('\n', pos)) {
+        ++pos;
+        if (strncasecmp(head.c_str() + pos, name, length) == 0 && head[pos + length] == ':') {
+            size_t begin = head.find_first_not_of(" \t", pos + length + 1);
+            size_t end = head.find_first_of("\r\n", begin);
+            if (begin == std::string::npos || end == std::string::npos)
+                return "";
+            return head.substr(begin, end - begin);
+        }
+    }
+    return "";
+}
+
+}  // namespace
+
+class TestHttpServer::Session
+{
+    TestHttpServer* server;
+    boost::asio::ip::tcp::socket socket;
+    boost::asio::streambuf input;
+    boost::asio::deadline_timer timer;
+    std::string output;
+    bool close;
+
+    void read() {
+        boost::asio::async_read_until(socket, input, "\r\n\r\n",
+                                      boost::bind(&Session::handleRead, this,
+                                                  boost::asio::placeholders::error,
+                                                  boost::asio::placeholders::bytes_transferred));
+    }
+
+    void handleRead(const boost::system::error_code& err, size_t length) {
+        if (err) {
+            delete this;
+            return;
+        }
+        std::string head(boost::asio::buffer_cast<const char*>(input.data()), length);
+        input.consume(length);
+        unsigned latency = 0;
+        output = server->respond(head, latency, close);
+        timer.expires_from_now(boost::posix_time::milliseconds(latency));
+        timer.async_wait(boost::bind(&Session::handleTimeout, this, boost::asio::placeholders::error));
+    }
+
+    void handleTimeout(const boost::system::error_code& err) {
+        if (err) {
+            delete this;
+            return;
+        }
+        boost::asio::async_write(socket, boost::asio::buffer(output),
+                                 boost::bind(&Session::handleWrite, this, boost::asio::placeholders::error));
+    }
+
+    void handleWrite(const boost::system::error_code& err) {
+        if (err || close) {
+            delete this;
+            return;
+        }
+        read();
+    }
+
+public:
+    Session(TestHttpServer* server) :
+        server(server),
+        socket(server->ioService),
+        timer(server->ioService),
+        close(false)
+    {
+    }
+
+    boost::asio::ip::tcp::socket& getSocket() {
+        return socket;
+    }
+
+    void start() {
+        boost::asio::ip::tcp::no_delay option(true);
+        boost::system::error_code ignored;
+        socket.set_option(option, ignored);
+        read();
+    }
+};
+
+TestHttpServer::TestHttpServer() :
+    acceptor(ioService),
+    keepAlive(true),
+    requestCount(0),
+    connectionCount(0),
+    octetCount(0),
+    partialCount(0)
+{
+}
+
+TestHttpServer::~TestHttpServer()
+{
+    stop();
+}
+
+bool TestHttpServer::start()
+{
+    boost::system::error_code err;
+    boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), 0);
+    acceptor.open(endpoint.protocol(), err);
+    if (!err)
+        acceptor.bind(endpoint, err);
+    if (!err)
+        acceptor.listen(boost::asio::socket_base::max_connections, err);
+    if (err)
+        return false;
+    accept();
+    thread = std::thread(boost::bind(&boost::asio::io_service::run, &ioService));
+    return true;
+}
+
+void TestHttpServer::stop()
+{
+    ioService.stop();
+    if (thread.joinable())
+        thread.join();
+}
+
+unsigned short TestHttpServer::getPort() const
+{
+    return acceptor.local_endpoint().port();
+}
+
+std::string TestHttpServer::getURL(const std::string& path) const
+{
+    std::ostringstream url;
+    url << "http://127.0.0.1:" << getPort() << path;
+    return url.str();
+}
+
+void TestHttpServer::setResource(const std::string& path, const Resource& resource)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    resources[path] = resource;
+}
+
+bool TestHttpServer::getResource(const std::string& path, Resource& resource)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = resources.find(path.substr(0, path.find('?')));
+    if (found == resources.end())
+        return false;
+    resource = found->second;
+    return true;
+}
+
+void TestHttpServer::accept()
+{
+    Session* session = new Session(this);
+    acceptor.async_accept(session->getSocket(), boost::bind(&TestHttpServer::handleAccept, this, session, boost::asio::placeholders::error));
+}
+
+void TestHttpServer::handleAccept(Session* session, const boost::system::error_code& err)
+{
+    if (err) {
+        delete session;
+        return;
+    }
+    ++connectionCount;
+    session->start();
+    accept();
+}
+
+// Composes the response to the request head.
+std::string TestHttpServer::respond(const std::string& head, unsigned& latency, bool& close)
+{
+    ++requestCount;
+    std::istringstream requestLine(head);
+    std::string method;
+    std::string path;
+    std::string version;
+    requestLine >> method >> path >> version;
+    close = !keepAlive || version != "HTTP/1.1" || strcasecmp(getHeader(head, "Connection").c_str(), "close") == 0;
+
+    std::ostringstream response;
+    Resource resource;
+    if (!getResource(path, resource)) {
+        response << "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n";
+        if (close)
+            response << "Connection: close\r\n";
+        response << "\r\n";
+        return response.str();
+    }
+    latency = resource.latency;
+
+    const char* status = "200 OK";
+    std::string body(resource.body);
+    std::string range;
+    std::string value = getHeader(head, "Range");
+    if (!resource.etag.empty() && getHeader(head, "If-None-Match") == resource.etag) {
+        status = "304 Not Modified";
+        body.clear();
+    } else if (resource.ranges && value.compare(0, 6, "bytes=") == 0) {
+        std::string validator = getHeader(head, "If-Range");
+        size_t first = strtoul(value.c_str() + 6, 0, 10);
+        if (first < body.length() && (validator.empty() || validator == resource.etag)) {
+            std::ostringstream contentRange;
+            contentRange << "bytes " << first << '-' << body.length() - 1 << '/' << body.length();
+            range = contentRange.str();
+            status = "206 Partial Content";
+            body.erase(0, first);
+            ++partialCount;
+        }
+    }
+
+    response << "HTTP/1.1 " << status << "\r\n";
+    if (!resource.etag.empty())
+        response << "ETag: " << resource.etag << "\r\n";
+    if (resource.ranges)
+        response << "Accept-Ranges: bytes\r\n";
+    if (!range.empty())
+        response << "Content-Range: " << range << "\r\n";
+    response << resource.headers;
+    if (close)
+        response << "Connection: close\r\n";
+    if (status[0] == '3') {
+        response << "\r\n";
+        return response.str();
+    }
+    response << "Content-Type: " << resource.contentType << "\r\n";
+    if (method == "HEAD")
+        body.clear();
+    octetCount += body.length();
+    if (!resource.chunkSize) {
+        response << "Content-Length: " << body.length() << "\r\n\r\n";
+        if (resource.truncate && resource.truncate < body.length() && value.empty()) {
+            // Let the client resume the rest.
+            octetCount -= body.length() - resource.truncate;
+            body.erase(resource.truncate);
+            close = true;
+        }
+        response << body;
+        return response.str();
+    }
+    response << "Transfer-Encoding: chunked\r\n\r\n";
+    for (size_t pos = 0; pos < body.length(); pos += resource.chunkSize) {
+        size_t length = std::min(resource.chunkSize, body.length() - pos);
+        char size[24];
+        sprintf(size, "%zx\r\n", length);
+        response << size;
+        response.write(body.c_str() + pos, length);
+        response << "\r\n";
+    }
+    response << "0\r\n\r\n";
+    return response.str();
+}
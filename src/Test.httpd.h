@@ -0,0 +1,111 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TEST_HTTPD_H
+#define TEST_HTTPD_H
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <boost/asio.hpp>
+
+// TestHttpServer serves canned responses over the loopback interface so
+// that the HTTP stack can be exercised without the network. It runs its
+// own I/O thread.
+class TestHttpServer
+{
+public:
+    struct Resource
+    {
+        std::string body;
+        std::string contentType;
+        std::string etag;       // answered with 304 to a matching If-None-Match
+        std::string headers;    // extra header fields, e.g., "Cache-Control: max-age=60\r\n"
+        unsigned latency;       // in milliseconds before the response is sent
+        size_t chunkSize;       // sent with the chunked transfer-coding unless 0
+        bool ranges;            // true to answer "Range: bytes=N-" with 206
+        size_t truncate;        // closes the connection after this many octets of the body unless 0;
+                                // a request with Range is not truncated
+
+        Resource(const std::string& body = "", const std::string& contentType = "text/plain") :
+            body(body),
+            contentType(contentType),
+            latency(0),
+            chunkSize(0),
+            ranges(false),
+            truncate(0)
+        {
+        }
+    };
+
+private:
+    class Session;
+
+    boost::asio::io_service ioService;
+    boost::asio::ip::tcp::acceptor acceptor;
+    std::thread thread;
+
+    std::mutex mutex;
+    std::map<std::string, Resource> resources;  // by path
+    bool keepAlive;
+
+    std::atomic_ullong requestCount;
+    std::atomic_ullong connectionCount;
+    std::atomic_ullong octetCount;   // the number of the body octets sent
+    std::atomic_ullong partialCount; // the number of the 206 responses
+
+    void accept();
+    void handleAccept(Session* session, const boost::system::error_code& err);
+    bool getResource(const std::string& path, Resource& resource);
+    std::string respond(const std::string& head, unsigned& latency, bool& close);
+
+public:
+    TestHttpServer();
+    ~TestHttpServer();
+
+    // Starts listening on an ephemeral port of 127.0.0.1.
+    bool start();
+    void stop();
+
+    unsigned short getPort() const;
+    // Returns the URL of the specified path on this server.
+    std::string getURL(const std::string& path) const;
+
+    // The query part of the request URL is ignored in looking up resources.
+    void setResource(const std::string& path, const Resource& resource);
+    // Closes every connection after the response if false.
+    void setKeepAlive(bool value) {
+        keepAlive = value;
+    }
+
+    unsigned long long getRequestCount() const {
+        return requestCount;
+    }
+    unsigned long long getConnectionCount() const {
+        return connectionCount;
+    }
+    unsigned long long getOctetCount() const {
+        return octetCount;
+    }
+    unsigned long long getPartialCount() const {
+        return partialCount;
+    }
+};
+
+#endif  // TEST_HTTPD_H
@@ -166,6 +166,13 @@ Document loadDocument(const char* html)
     return loadDocument(stream);
 }
 
+int checkResult(const char* description, bool result)
+{
+    std::cout << "description: " << description << '\n';
+    std::cout << (result ? "PASS\n" : "FAIL\n");
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 unsigned recordTime(const char* msg, ...)
 {
     typedef std::chrono::high_resolution_clock Clock;
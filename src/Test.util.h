@@ -42,6 +42,10 @@ org::w3c::dom::css::CSSStyleSheet loadStyleSheet(const char* path);
 org::w3c::dom::Document loadDocument(std::istream& stream);
 org::w3c::dom::Document loadDocument(const char* html);
 
+// Prints the description followed by PASS or FAIL, and returns EXIT_SUCCESS
+// or EXIT_FAILURE accordingly.
+int checkResult(const char* description, bool result);
+
 unsigned recordTime(const char* msg, ...);
 unsigned getTick();
 
@@ -23,6 +23,10 @@
 
 #include <algorithm>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 const char* U16ConverterInputStream::DefaultEncoding = "utf-8";
 
 namespace {
@@ -161,14 +165,19 @@ void U16ConverterInputStream::setEncoding(std::string value, bool useDefault)
         if (!converter)
             eof = true;
     }
+    if (converter)
+        utf8 = !strcmp(ucnv_getName(converter, &error), "UTF-8");
     encoding = value;
 }
 
 void U16ConverterInputStream::initializeConverter()
 {
     flush = false;
+    partial = false;
+    sourceOffset = sourceAvailable = 0;
     eof = !stream;
     converter = 0;
+    utf8 = false;
     source = sourceLimit = sourceBuffer;
     target = targetBuffer;
     nextChar = target;
@@ -183,10 +192,16 @@ void U16ConverterInputStream::updateSource()
         memmove(sourceBuffer, source, count);
     source = sourceBuffer;
     sourceLimit = sourceBuffer + count;
-    count = ChunkSize - count;
+    // Read the first chunk alone to detect the character encoding from it.
+    count = (converter ? BufferSize : ChunkSize) - count;
+    if (partial) {
+        count = std::min(static_cast<unsigned long long>(count), sourceAvailable - sourceOffset);
+        stream.clear();
+    }
     if (0 < count) {
         stream.read(sourceLimit, count);
         count = stream.gcount();
+        sourceOffset += count;
         if (!converter) {
             bool useDefault = true;
             if (encoding.empty()) {
@@ -196,19 +211,194 @@ void U16ConverterInputStream::updateSource()
             setEncoding(encoding, useDefault);
         }
         sourceLimit += count;
-        if (count == 0)
+        if (count == 0 && !partial)
             flush = true;
     }
 }
 
+bool U16ConverterInputStream::canRead(size_t count) const
+{
+    if (!partial || eof)
+        return true;
+    // Wait for the first chunk so that the character encoding can be
+    // detected from it.
+    if (!converter)
+        return ChunkSize <= sourceAvailable;
+    // Note a character takes at most four bytes in the source.
+    unsigned long long bytes = (sourceLimit - source) + (sourceAvailable - sourceOffset);
+    return count <= (target - nextChar) + bytes / 4;
+}
+
+namespace {
+
+inline bool isSpecial(char16_t c, char16_t stop1, char16_t stop2)
+{
+    return c == stop1 || c == stop2 || c == '\r' || c == '\0' || c == 0xFEFF;
+}
+
+// Returns the position of the first special character in [p, end).
+const char16_t* findSpecial(const char16_t* p, const char16_t* end, char16_t stop1, char16_t stop2)
+{
+#ifdef __SSE2__
+    const __m128i s1 = _mm_set1_epi16(stop1);
+    const __m128i s2 = _mm_set1_epi16(stop2);
+    const __m128i cr = _mm_set1_epi16('\r');
+    const __m128i bom = _mm_set1_epi16(static_cast<short>(0xFEFF));
+    const __m128i zero = _mm_setzero_si128();
+    for (; p + 8 <= end; p += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi16(v, s1), _mm_cmpeq_epi16(v, s2)),
+                                 _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi16(v, cr), _mm_cmpeq_epi16(v, zero)),
+                                              _mm_cmpeq_epi16(v, bom)));
+        if (int mask = _mm_movemask_epi8(m))
+            return p + __builtin_ctz(mask) / 2;
+    }
+#endif
+    for (; p < end; ++p) {
+        if (isSpecial(*p, stop1, stop2))
+            break;
+    }
+    return p;
+}
+
+}
+
+size_t U16ConverterInputStream::read(char16_t* buffer, size_t count)
+{
+    size_t n = 0;
+    while (n < count) {
+        if (lastChar != '\r') {
+            const char16_t* end = findSpecial(nextChar, std::min(target, nextChar + (count - n)), '\r', '\r');
+            if (size_t length = end - nextChar) {
+                memcpy(buffer + n, nextChar, length * sizeof(char16_t));
+                n += length;
+                lastChar = end[-1];
+                nextChar += length;
+                continue;
+            }
+        }
+        // Let peek() handle special characters and refill the buffer.
+        if (peek() == -1)
+            break;
+        char16_t c;
+        get(c);
+        buffer[n++] = c;
+    }
+    return n;
+}
+
+size_t U16ConverterInputStream::readRun(std::u16string& text, char16_t stop1, char16_t stop2)
+{
+    // A LF right after CR has to be skipped by peek().
+    if (eof || lastChar == '\r')
+        return 0;
+    const char16_t* end = findSpecial(nextChar, target, stop1, stop2);
+    size_t count = end - nextChar;
+    if (count) {
+        text.append(nextChar, count);
+        lastChar = end[-1];
+        nextChar += count;
+    }
+    return count;
+}
+
+// Decodes UTF-8 as specified in the Encoding Standard, replacing each
+// maximal subpart of an ill-formed sequence with U+FFFD. An incomplete
+// sequence at the end of the source is left there unless flushing.
+void U16ConverterInputStream::decodeUTF8()
+{
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(source);
+    const unsigned char* end = reinterpret_cast<const unsigned char*>(sourceLimit);
+    char16_t* t = target;
+    char16_t* limit = targetBuffer + BufferSize;
+    while (s < end && t < limit) {
+#ifdef __SSE2__
+        // Widen runs of ASCII characters sixteen at a time.
+        const __m128i zero = _mm_setzero_si128();
+        while (s + 16 <= end && t + 16 <= limit) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            if (_mm_movemask_epi8(v))
+                break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(t), _mm_unpacklo_epi8(v, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(t + 8), _mm_unpackhi_epi8(v, zero));
+            s += 16;
+            t += 16;
+        }
+        if (end <= s || limit <= t)
+            break;
+#endif
+        char32_t c = *s;
+        if (c < 0x80) {
+            *t++ = c;
+            ++s;
+            continue;
+        }
+        unsigned need;
+        unsigned char lower = 0x80;
+        unsigned char upper = 0xbf;
+        if (0xc2 <= c && c <= 0xdf) {
+            need = 1;
+            c &= 0x1f;
+        } else if (0xe0 <= c && c <= 0xef) {
+            need = 2;
+            if (c == 0xe0)
+                lower = 0xa0;
+            else if (c == 0xed)
+                upper = 0x9f;
+            c &= 0x0f;
+        } else if (0xf0 <= c && c <= 0xf4) {
+            need = 3;
+            if (c == 0xf0)
+                lower = 0x90;
+            else if (c == 0xf4)
+                upper = 0x8f;
+            c &= 0x07;
+            if (limit - t < 2)
+                break;  // no room for a surrogate pair
+        } else {
+            *t++ = 0xfffd;
+            ++s;
+            continue;
+        }
+        const unsigned char* p = s + 1;
+        for (; need; --need, ++p) {
+            if (p == end || *p < lower || upper < *p)
+                break;
+            c = (c << 6) | (*p & 0x3f);
+            lower = 0x80;
+            upper = 0xbf;
+        }
+        if (p == end && need && !flush)
+            break;  // wait for the rest of the sequence
+        s = p;
+        if (need)
+            *t++ = 0xfffd;
+        else if (c < 0x10000)
+            *t++ = c;
+        else {
+            c -= 0x10000;
+            *t++ = 0xd800 | (c >> 10);
+            *t++ = 0xdc00 | (c & 0x3ff);
+        }
+    }
+    source = const_cast<char*>(reinterpret_cast<const char*>(s));
+    target = t;
+}
+
 void U16ConverterInputStream::readChunk()
 {
     nextChar = target = targetBuffer;
     updateSource();
+    if (!converter)
+        return;
+    if (utf8) {
+        decodeUTF8();
+        return;
+    }
     UErrorCode err = U_ZERO_ERROR;
     ucnv_toUnicode(converter,
                    reinterpret_cast<UChar**>(&target),
-                   reinterpret_cast<UChar*>(targetBuffer) + ChunkSize,
+                   reinterpret_cast<UChar*>(targetBuffer) + BufferSize,
                    const_cast<const char**>(&source),
                    sourceLimit, 0, flush, &err);
 }
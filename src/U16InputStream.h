@@ -33,6 +33,32 @@ public:
     virtual int peek() = 0;
     virtual U16InputStream& get(char16_t& c) = 0;
 
+    // Returns false if reading the next count characters might hit the end
+    // of the input available so far, i.e., more input is expected to arrive
+    // later.
+    virtual bool canRead(size_t count) const {
+        return true;
+    }
+
+    // Appends to text the characters up to, but not including, the next
+    // stop1, stop2, or a character that needs special handling like CR and
+    // NUL. Only the characters that have already been decoded are scanned.
+    // Returns the number of the characters appended.
+    virtual size_t readRun(std::u16string& text, char16_t stop1, char16_t stop2) {
+        return 0;
+    }
+
+    // Reads up to count characters into buffer, and returns the number of
+    // the characters read. Fewer characters are read only at the end of the
+    // input, or of the input available so far.
+    virtual size_t read(char16_t* buffer, size_t count) {
+        size_t n = 0;
+        char16_t c;
+        while (n < count && get(c))
+            buffer[n++] = c;
+        return n;
+    }
+
     int get() {
         char16_t c;
         get(c);
@@ -41,9 +67,9 @@ public:
     operator std::u16string()
     {
         std::u16string text;
-        char16_t c;
-        while (get(c))
-            text += c;
+        char16_t buffer[1024];
+        while (size_t n = read(buffer, sizeof buffer / sizeof buffer[0]))
+            text.append(buffer, n);
         return text;
     }
 };
@@ -75,7 +101,8 @@ public:
 class U16ConverterInputStream : public U16InputStream
 {
 public:
-    static const size_t ChunkSize = 512;
+    static const size_t ChunkSize = 512;      // for detecting the character encoding
+    static const size_t BufferSize = 8192;
     static const char* DefaultEncoding;  // "utf-8"
     enum Confidence
     {
@@ -124,21 +151,26 @@ protected:
 
 private:
     UConverter* converter;
+    bool utf8;      // true to decode UTF-8 without converter
 
     std::istream& stream;
 
     bool eof;
     bool flush;
-    char sourceBuffer[ChunkSize + 1];
+    bool partial;   // true while more bytes can be appended to stream
+    unsigned long long sourceOffset;     // the number of bytes read from stream
+    unsigned long long sourceAvailable;  // the number of bytes that can be read from stream while partial
+    char sourceBuffer[BufferSize + 1];
     char* source;
     char* sourceLimit;
-    char16_t targetBuffer[ChunkSize];
+    char16_t targetBuffer[BufferSize];
     char16_t* target;
     char16_t* nextChar;
     char16_t lastChar;
 
     void initializeConverter();
     void updateSource();
+    void decodeUTF8();
     void readChunk();
 
 public:
@@ -177,17 +209,20 @@ public:
                 }
                 return c;
             }
-            if (!flush)
-                readChunk();
-            else
+            if (flush)
                 eof = true;
+            else {
+                readChunk();
+                if (partial && nextChar == target)
+                    break;
+            }
         }
         return -1;
     }
     virtual U16ConverterInputStream& get(char16_t& c)
     {
         int ch = peek();
-        if (!eof) {
+        if (!eof && ch != -1) {
             lastChar = *nextChar;
             ++nextChar;
             c = static_cast<char16_t>(ch);
@@ -195,6 +230,23 @@ public:
         return *this;
     }
 
+    // While stream is still being written (e.g., the document is being
+    // downloaded), setAvailable() tells how many bytes of stream can be
+    // read so far. setComplete() marks the end of stream.
+    void setAvailable(unsigned long long length) {
+        partial = true;
+        sourceAvailable = length;
+    }
+    void setComplete() {
+        if (partial) {
+            partial = false;
+            stream.clear();
+        }
+    }
+    virtual bool canRead(size_t count) const;
+    virtual size_t read(char16_t* buffer, size_t count);
+    virtual size_t readRun(std::u16string& text, char16_t stop1, char16_t stop2);
+
     enum Confidence getConfidence() const {
         return confidence;
     }
@@ -16,6 +16,7 @@
 
 #include "WindowImp.h"
 
+#include <algorithm>
 #include <new>
 #include <iostream>
 #include <boost/version.hpp>
@@ -42,13 +43,50 @@
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
-WindowImp::Parser::Parser(DocumentImp* document, int fd, const std::string& optionalEncoding) :
-    stream(fd, boost::iostreams::close_handle),
-    htmlInputStream(stream, optionalEncoding),
+namespace {
+
+const unsigned MillisecondsPerTick = 10;
+
+// in ticks
+const unsigned ParseTimeSlice = 4;
+const unsigned ProgressiveRenderInterval = 20;
+
+}
+
+WindowImp::Parser::Parser(DocumentImp* document, HttpRequest& request, const DocumentWindowPtr& window) :
+    stream(request),
+    htmlInputStream(stream, request.getContentCharset()),
     tokenizer(&htmlInputStream),
-    parser(document, &tokenizer)
+    parser(document, &tokenizer),
+    preloadStream(request),
+    preloadScanner(window, document->getDocumentURI()),
+    preloaded(0),
+    tokenizerThread(&tokenizer, &htmlInputStream, request.getContentOctetCount(), HttpRequest::COMPLETE <= request.getReadyState())
+{
+    document->setCharacterSet(utfconv(tokenizerThread.getEncoding()));
+}
+
+void WindowImp::Parser::update(HttpRequest& request)
 {
-    document->setCharacterSet(utfconv(htmlInputStream.getEncoding()));
+    tokenizerThread.update(request.getContentOctetCount(), HttpRequest::COMPLETE <= request.getReadyState());
+}
+
+void WindowImp::Parser::preload(HttpRequest& request)
+{
+    // The preload scanner works on the undecoded octets.
+    if (tokenizerThread.getEncoding().compare(0, 6, "utf-16") == 0)
+        return;
+    unsigned long long available = (HttpRequest::COMPLETE <= request.getReadyState()) ? ~0ull : request.getContentOctetCount();
+    char buffer[4096];
+    while (preloaded < available) {
+        preloadStream.clear();
+        preloadStream.read(buffer, std::min<unsigned long long>(sizeof buffer, available - preloaded));
+        std::streamsize count = preloadStream.gcount();
+        if (count <= 0)
+            break;
+        preloadScanner.scan(buffer, count);
+        preloaded += count;
+    }
 }
 
 WindowImp::WindowImp(WindowImp* parent, ElementImp* frameElement, unsigned short flags) :
@@ -72,9 +110,12 @@ WindowImp::WindowImp(WindowImp* parent, ElementImp* frameElement, unsigned short
     redisplay(false),
     zoomable(true),
     zoom(1.0f),
+    parseTick(0),
     faviconOverridable(false),
     windowDepth(0)
 {
+    request.setPriority(HttpRequest::DOCUMENT_PRIORITY);
+    request.setProgressHandler(boost::bind(&WindowImp::handleProgress, this, _1, _2));
     if (parent) {
         parent->childWindows.push_back(this);
         windowDepth = parent->windowDepth + 1;
@@ -198,6 +239,17 @@ bool WindowImp::isBindingDocumentWindow() const
     return document->isBindingDocumentWindow(this);
 }
 
+// Called as the document is being downloaded, and once more upon completion.
+void WindowImp::handleProgress(unsigned long long offset, unsigned long long length)
+{
+    if (parser) {
+        // Let the tokenizer thread proceed without waiting for poll().
+        parser->update(request);
+        // Start fetching subresources as soon as their URLs have arrived.
+        parser->preload(request);
+    }
+}
+
 bool WindowImp::poll()
 {
     if (!window)
@@ -205,7 +257,7 @@ bool WindowImp::poll()
     DocumentImp* document = dynamic_cast<DocumentImp*>(window->getDocument().self());
 
     // Update the canvas before processing events.
-    if (request.getReadyState() == HttpRequest::DONE && document && backgroundTask.getState() == BackgroundTask::Done) {
+    if (HttpRequest::LOADING <= request.getReadyState() && document && backgroundTask.getState() == BackgroundTask::Done) {
         ViewCSSImp* next = backgroundTask.getView();
         updateView(next);
         if (view && (view->gatherFlags() & Box::NEED_REPAINT)) {
@@ -254,8 +306,14 @@ bool WindowImp::poll()
         break;
     case HttpRequest::OPENED:
     case HttpRequest::HEADERS_RECEIVED:
-    case HttpRequest::LOADING:
         break;
+    case HttpRequest::LOADING:
+    case HttpRequest::COMPLETE:
+        // Start parsing the document once the first chunk has been
+        // downloaded so that its character encoding can be detected.
+        if (!document && request.getContentOctetCount() < U16ConverterInputStream::ChunkSize)
+            break;
+        // FALL THROUGH
     case HttpRequest::DONE:
         if (!document) {
             recordTime("%*shttp request done", windowDepth * 2, "");
@@ -272,7 +330,8 @@ bool WindowImp::poll()
                 else
                     document->setError(request.getError());
                 document->enter();
-                parser.reset(new(std::nothrow) Parser(document, request.getContentDescriptor(), request.getResponseMessage().getContentCharset()));
+                parser.reset(new(std::nothrow) Parser(document, request, window));
+                parseTick = getTick();
                 document->exit();
                 if (!parser)
                     break;  // TODO: error handling
@@ -280,9 +339,16 @@ bool WindowImp::poll()
                 break;  // TODO: error handling
         }
         if (document->getReadyState() == u"loading") {
-            // TODO: Note white it would be nice to parse the HTML docucment in
-            // the background task, firstly we need to check if we can run JS
-            // in the background.
+            // The tokenizer runs on its own thread; the tree builder stays
+            // here since scripts have to run on the main thread.
+
+            // Start fetching subresources even if the parser is blocked.
+            parser->preload(request);
+
+            // Do not modify the document while the background task is using it.
+            int state = backgroundTask.getState();
+            if (state == BackgroundTask::Cascading || state == BackgroundTask::Layouting)
+                break;
 
             document->enter();
 
@@ -290,29 +356,55 @@ bool WindowImp::poll()
                 document->exit();
                 break;
             }
-            // TODO: run this in the background
-            Token token;
-            do {
-                token = parser->getToken();
+            unsigned start = getTick();
+            bool eof = false;
+            for (;;) {
+                if (!parser->isReady()) {
+                    // Wait for the tokens being produced within the time slice;
+                    // otherwise parse them at the next poll().
+                    unsigned elapsed = getTick() - start;
+                    if (parser->isBusy() && elapsed < ParseTimeSlice && parser->wait((ParseTimeSlice - elapsed) * MillisecondsPerTick))
+                        continue;
+                    break;
+                }
+                Token token = parser->getToken();
                 parser->processToken(token);
-            } while (token.getType() != Token::Type::EndOfFile && !document->getPendingParsingBlockingScript());
+                if (token.getType() == Token::Type::EndOfFile) {
+                    eof = true;
+                    break;
+                }
+                if (document->getPendingParsingBlockingScript() || ParseTimeSlice <= getTick() - start)
+                    break;
+            }
 
             if (document->getPendingParsingBlockingScript()) {
                 document->exit();
                 break;
             }
 
-            // TODO: Check if the parser has been aborted.
-            document->resetStyleSheets();
-            if (WindowImp* view = document->getDefaultWindow())
-                view->setViewFlags(Box::NEED_SELECTOR_REMATCHING);
+            if (!eof) {
+                // Render the partially parsed document now and then.
+                if (getTick() - parseTick < ProgressiveRenderInterval) {
+                    document->exit();
+                    break;
+                }
+                parseTick = getTick();
+                document->resetStyleSheets();
+                setViewFlags(Box::NEED_SELECTOR_REMATCHING);
+                document->exit();
+            } else {
+                // TODO: Check if the parser has been aborted.
+                document->resetStyleSheets();
+                if (WindowImp* view = document->getDefaultWindow())
+                    view->setViewFlags(Box::NEED_SELECTOR_REMATCHING);
 
-            parser.reset();
-            document->exit();
+                parser.reset();
+                document->exit();
 
-            recordTime("%*shtml parsed", windowDepth * 2, "");
-            if (4 <= getLogLevel())
-                dumpTree(std::cerr, document);
+                recordTime("%*shtml parsed", windowDepth * 2, "");
+                if (4 <= getLogLevel())
+                    dumpTree(std::cerr, document);
+            }
         }
 
         switch (backgroundTask.getState()) {
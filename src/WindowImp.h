@@ -46,9 +46,6 @@
 #include <mutex>
 #include <thread>
 
-#include <boost/iostreams/stream.hpp>
-#include <boost/iostreams/device/file_descriptor.hpp>
-
 #include <org/w3c/dom/css/CSSStyleSheet.h>
 
 #include "Canvas.h"
@@ -60,6 +57,9 @@
 #include "NavigatorImp.h"
 #include "html/HTMLInputStream.h"
 #include "html/HTMLParser.h"
+#include "html/HTMLPreloadScanner.h"
+#include "html/HTMLTokenizerThread.h"
+#include "http/HTTPContentStream.h"
 #include "http/HTTPRequest.h"
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
@@ -166,21 +166,39 @@ private:
 
     class Parser
     {
-        boost::iostreams::stream<boost::iostreams::file_descriptor_source> stream;
+        HttpContentStream stream;
         HTMLInputStream htmlInputStream;
         HTMLTokenizer tokenizer;
         HTMLParser parser;
+        HttpContentStream preloadStream;
+        HTMLPreloadScanner preloadScanner;
+        unsigned long long preloaded;  // octets fed to preloadScanner
+        HTMLTokenizerThread tokenizerThread;
     public:
-        Parser(DocumentImp* document, int fd, const std::string& optionalEncoding);
-
+        Parser(DocumentImp* document, HttpRequest& request, const DocumentWindowPtr& window);
+
+        // Tells the input stream how much of the content has been downloaded.
+        void update(HttpRequest& request);
+        // Scans the newly downloaded content ahead of the tree builder.
+        void preload(HttpRequest& request);
+        bool isReady() {
+            return tokenizerThread.isReady();
+        }
         Token getToken() {
-            return tokenizer.getToken();
+            return tokenizerThread.getToken();
+        }
+        // Returns true if more tokens are on the way from the tokenizer thread.
+        bool isBusy() const {
+            return tokenizerThread.isBusy();
+        }
+        bool wait(unsigned milliseconds) {
+            return tokenizerThread.wait(milliseconds);
         }
         bool processToken(Token& token) {
             return parser.processToken(token);
         }
-        const std::string& getEncoding() {
-            return htmlInputStream.getEncoding();
+        std::string getEncoding() {
+            return tokenizerThread.getEncoding();
         }
 
         bool processPendingParsingBlockingScript() {
@@ -207,6 +225,7 @@ private:
     std::deque<EventTask> eventQueue;
 
     std::unique_ptr<Parser> parser;
+    unsigned parseTick;  // when the partially parsed document has been rendered last
 
     // for MouseEvent
     Element clickTarget;
@@ -236,6 +255,7 @@ private:
     void navigateToFragmentIdentifier(URL target);
     WindowImp* selectBrowsingContext(std::u16string target, bool& replace);
     void navigate(std::u16string url, bool replace, WindowImp* srcWindow);
+    void handleProgress(unsigned long long offset, unsigned long long length);
 
 public:
     WindowImp(WindowImp* parent = 0, ElementImp* frameElement = 0, unsigned short flags = 0);
@@ -543,6 +543,7 @@ void Block::resolveBackground(ViewCSSImp* view)
         backgroundRequest = new(std::nothrow) HttpRequest(document->getDocumentURI());
         if (backgroundRequest) {
             backgroundRequest->open(u"GET", style->backgroundImage.getValue());
+            backgroundRequest->setPriority(HttpRequest::LOW_PRIORITY);
             backgroundRequest->setHandler(boost::bind(&Block::notifyBackground, this, view->getDocument()));
             document->incrementLoadEventDelayCount();
             retain_();
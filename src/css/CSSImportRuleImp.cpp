@@ -18,8 +18,6 @@
 
 #include <boost/bind.hpp>
 #include <boost/version.hpp>
-#include <boost/iostreams/stream.hpp>
-#include <boost/iostreams/device/file_descriptor.hpp>
 
 #include "DocumentImp.h"
 #include "WindowImp.h"
@@ -28,7 +26,7 @@
 #include "CSSParser.h"
 #include "CSSStyleSheetImp.h"
 
-#include "http/HTTPRequest.h"
+#include "http/HTTPContentStream.h"
 
 #include "Test.util.h"
 
@@ -93,6 +91,7 @@ css::CSSStyleSheet CSSImportRuleImp::getStyleSheet()
         request = new(std::nothrow) HttpRequest(document->getDocumentURI());
         if (request) {
             request->open(u"GET", href);
+            request->setPriority(HttpRequest::BLOCKING_PRIORITY);
             request->setHandler(boost::bind(&CSSImportRuleImp::notify, this));
             document->incrementLoadEventDelayCount();
             request->send();
@@ -104,7 +103,7 @@ css::CSSStyleSheet CSSImportRuleImp::getStyleSheet()
 void CSSImportRuleImp::notify()
 {
     if (request->getStatus() == 200) {
-        boost::iostreams::stream<boost::iostreams::file_descriptor_source> stream(request->getContentDescriptor(), boost::iostreams::close_handle);
+        HttpContentStream stream(*request);
         CSSParser parser(request->getRequestMessage().getURL());
         CSSInputStream cssStream(stream, request->getResponseMessage().getContentCharset(), utfconv(document->getCharacterSet()));
         styleSheet = parser.parse(document, cssStream);
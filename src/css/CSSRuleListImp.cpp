@@ -49,9 +49,9 @@ void CSSRuleListImp::appendClass(CSSSelector* selector, CSSStyleDeclarationImp*
     mapClass.insert(std::pair<std::u16string, Rule>(key, Rule{ selector, declaration, ++order }));
 }
 
-void CSSRuleListImp::appendType(CSSSelector* selector, CSSStyleDeclarationImp* declaration, const std::u16string& key)
+void CSSRuleListImp::appendType(CSSSelector* selector, CSSStyleDeclarationImp* declaration, Atom key)
 {
-    mapType.insert(std::pair<std::u16string, Rule>(key, Rule{ selector, declaration, ++order }));
+    mapType.insert(std::pair<Atom, Rule>(key, Rule{ selector, declaration, ++order }));
 }
 
 void CSSRuleListImp::append(css::CSSRule rule, DocumentImp* document)
@@ -126,7 +126,17 @@ void CSSRuleListImp::findByClass(RuleSet& set, ViewCSSImp* view, Element& elemen
 
 void CSSRuleListImp::findByType(RuleSet& set, ViewCSSImp* view, Element& element)
 {
-    find(set, view, element, mapType, element.getLocalName());
+    ElementImp* imp = dynamic_cast<ElementImp*>(element.self());
+    if (!imp)
+        return;
+    auto range = mapType.equal_range(imp->getLocalNameAtom());
+    for (auto i = range.first; i != range.second; ++i) {
+        CSSSelector* selector = i->second.selector;
+        if (!selector->match(element, view, false))
+            continue;
+        PrioritizedRule rule(importance, i->second);
+        set.insert(rule);
+    }
 }
 
 void CSSRuleListImp::findMisc(RuleSet& set, ViewCSSImp* view, Element& element)
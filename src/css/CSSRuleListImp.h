@@ -24,6 +24,9 @@
 #include <list>
 #include <map>
 #include <set>
+#include <unordered_map>
+
+#include "Atom.h"
 
 #include "CSSImportRuleImp.h"
 #include "CSSStyleRuleImp.h"
@@ -107,7 +110,7 @@ private:
     std::deque<CSSImportRuleImp*> importList;
     std::multimap<std::u16string, Rule> mapID;     // ID selectors
     std::multimap<std::u16string, Rule> mapClass;  // class selectors
-    std::multimap<std::u16string, Rule> mapType;   // type selectors
+    std::unordered_multimap<Atom, Rule> mapType;   // type selectors
     std::deque<Rule> misc;
 
     void find(RuleSet& set, ViewCSSImp* view, Element& element, std::multimap<std::u16string, Rule>& map, const std::u16string& key);
@@ -127,7 +130,7 @@ public:
     void appendMisc(CSSSelector* selector, CSSStyleDeclarationImp* declaration);
     void appendID(CSSSelector* selector, CSSStyleDeclarationImp* declaration, const std::u16string& key);
     void appendClass(CSSSelector* selector, CSSStyleDeclarationImp* declaration, const std::u16string& key);
-    void appendType(CSSSelector* selector, CSSStyleDeclarationImp* declaration, const std::u16string& key);
+    void appendType(CSSSelector* selector, CSSStyleDeclarationImp* declaration, Atom key);
 
     void find(RuleSet& set, ViewCSSImp* view, Element& element, unsigned importance);
 
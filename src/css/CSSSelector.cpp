@@ -23,6 +23,7 @@
 
 #include "CSSStyleDeclarationImp.h"
 #include "CSSRuleListImp.h"
+#include "ElementImp.h"
 #include "ViewCSSImp.h"
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
@@ -151,8 +152,9 @@ CSSSpecificity CSSSelector::getSpecificity()
 
 bool CSSPrimarySelector::match(Element& e, ViewCSSImp* view, bool dynamic)
 {
-    if (name != u"*") {
-        if (e.getLocalName() != name)
+    if (!tag.empty()) {
+        ElementImp* element = dynamic_cast<ElementImp*>(e.self());
+        if (!element || element->getLocalNameAtom() != tag)
             return false;
         if (namespacePrefix != u"*") {
             if (!e.getNamespaceURI().hasValue() || e.getNamespaceURI().value() != namespacePrefix)
@@ -387,7 +389,7 @@ void CSSPrimarySelector::registerToRuleList(CSSRuleListImp* ruleList, CSSSelecto
         if (name == u"*")
             ruleList->appendMisc(selector, declaration);
         else
-            ruleList->appendType(selector, declaration, name);
+            ruleList->appendType(selector, declaration, tag);
         return;
     }
     bool hadID = false;
@@ -424,6 +426,22 @@ CSSPseudoElementSelector* CSSSelector::getPseudoElement() const
     return simpleSelectors.back()->getPseudoElement();
 }
 
+const std::u16string* CSSPrimarySelector::getID() const
+{
+    for (auto i = chain.begin(); i != chain.end(); ++i) {
+        if (CSSIDSelector* id = dynamic_cast<CSSIDSelector*>(*i))
+            return &id->getName();
+    }
+    return 0;
+}
+
+const std::u16string* CSSSelector::getID() const
+{
+    if (simpleSelectors.empty())
+        return 0;
+    return simpleSelectors.back()->getID();
+}
+
 CSSPseudoClassSelector::CSSPseudoClassSelector(const std::u16string& ident, int id) :
     CSSPseudoSelector(getPseudoClassName(id)),
     id(id)
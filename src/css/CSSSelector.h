@@ -28,6 +28,7 @@
 #include <Object.h>
 #include <org/w3c/dom/Element.h>
 
+#include "Atom.h"
 #include "CSSParser.h"
 #include "CSSSerialize.h"
 #include "utf.h"
@@ -127,6 +128,7 @@ public:
 private:
     int combinator;
     std::u16string namespacePrefix;  // IDENT, '*', or empty
+    Atom tag;   // name as an atom unless name is '*'
     std::deque<CSSSimpleSelector*> chain;
 public:
     CSSPrimarySelector() :
@@ -141,7 +143,12 @@ public:
     CSSPrimarySelector(const std::u16string& namespacePrefix, const std::u16string& elementName) :
         CSSSimpleSelector(elementName),
         combinator(None),
-        namespacePrefix(namespacePrefix) {
+        namespacePrefix(namespacePrefix),
+        tag(elementName != u"*" ? Atom(elementName) : Atom()) {
+    }
+    void setName(const std::u16string& name) {
+        CSSSimpleSelector::setName(name);
+        tag = (name != u"*") ? Atom(name) : Atom();
     }
     void append(CSSSimpleSelector* selector) {
         if (selector)
@@ -167,6 +174,7 @@ public:
     virtual bool hasPseudoClassSelector(int type) const;
     void registerToRuleList(CSSRuleListImp* ruleList, CSSSelector* selector, CSSStyleDeclarationImp* declaration);
     CSSPseudoElementSelector* getPseudoElement() const;
+    const std::u16string* getID() const;
 };
 
 // '#' IDENT
@@ -456,6 +464,9 @@ public:
     bool match(Element& element, ViewCSSImp* view, bool dynamic);
     CSSPseudoElementSelector* getPseudoElement() const;
 
+    // Returns the ID that the subject of this selector must have, or 0.
+    const std::u16string* getID() const;
+
     bool isValid() const;
     bool hasPseudoClassSelector(int type) const;
     bool hasHover() const {
@@ -494,6 +505,13 @@ public:
         return true;
     }
 
+    // Returns the ID that every matching element must have, or 0.
+    const std::u16string* getID() const {
+        if (selectors.size() != 1)
+            return 0;
+        return selectors.front()->getID();
+    }
+
     bool evaluate(Element element, ViewCSSImp* view) {
         for (auto i = selectors.begin(); i != selectors.end(); ++i) {
             if ((*i)->match(element, view, true))
@@ -51,6 +51,7 @@ void HTMLImageElementImp::handleMutation(events::MutationEvent mutation)
             current = new(std::nothrow) HttpRequest(document->getDocumentURI());
             if (current) {
                 current->open(u"GET", getSrc());
+                current->setPriority(HttpRequest::LOW_PRIORITY);
                 current->setHandler(boost::bind(&HTMLImageElementImp::notify, this, current));
                 document->incrementLoadEventDelayCount();
                 current->send();
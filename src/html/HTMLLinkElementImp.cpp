@@ -18,8 +18,6 @@
 
 #include <boost/bind.hpp>
 #include <boost/version.hpp>
-#include <boost/iostreams/stream.hpp>
-#include <boost/iostreams/device/file_descriptor.hpp>
 
 #include "one_at_a_time.hpp"
 
@@ -34,6 +32,7 @@ constexpr auto Intern = &one_at_a_time::hash<char16_t>;
 #include "css/CSSParser.h"
 #include "css/CSSStyleSheetImp.h"
 #include "css/Ico.h"
+#include "http/HTTPContentStream.h"
 
 #include "Test.util.h"
 
@@ -129,6 +128,7 @@ void HTMLLinkElementImp::refresh()
                     current = new(std::nothrow) HttpRequest(document->getDocumentURI());
                     if (current) {
                         current->open(u"GET", href);
+                        current->setPriority(HttpRequest::BLOCKING_PRIORITY);
                         current->setHandler(boost::bind(&HTMLLinkElementImp::linkStyleSheet, this, current));
                         document->incrementLoadEventDelayCount();
                         current->send();
@@ -142,6 +142,7 @@ void HTMLLinkElementImp::refresh()
             current = new(std::nothrow) HttpRequest(document->getDocumentURI());
             if (current) {
                 current->open(u"GET", href);
+                current->setPriority(HttpRequest::LOW_PRIORITY);
                 current->setHandler(boost::bind(&HTMLLinkElementImp::linkIcon, this, current));
                 document->incrementLoadEventDelayCount();
                 current->send();
@@ -158,7 +159,7 @@ void HTMLLinkElementImp::linkStyleSheet(HttpRequest* request)
 
     DocumentImp* document = getOwnerDocumentImp();
     if (current->getStatus() == 200) {
-        boost::iostreams::stream<boost::iostreams::file_descriptor_source> stream(current->getContentDescriptor(), boost::iostreams::close_handle);
+        HttpContentStream stream(*current);
         CSSParser parser(current->getRequestMessage().getURL());
         CSSInputStream cssStream(stream, current->getResponseMessage().getContentCharset(), utfconv(document->getCharacterSet()));
         styleSheet = parser.parse(document, cssStream);
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HTMLLiveCollectionImp.h"
+
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+
+#include "utf.h"
+#include "DocumentImp.h"
+#include "ElementImp.h"
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+HTMLLiveCollectionImp::HTMLLiveCollectionImp(NodeImp* root, DocumentImp* document, int type, const std::u16string& key) :
+    root(root),
+    document(document),
+    type(type),
+    key(key),
+    version(document ? document->getDOMVersion() : 0),
+    complete(false)
+{
+    if (type == TagName) {
+        if (key != u"*")
+            name = Atom(key);
+    } else {
+        boost::algorithm::split(classes, key, isSpace, boost::algorithm::token_compress_on);
+        classes.erase(std::remove(classes.begin(), classes.end(), u""), classes.end());
+    }
+}
+
+HTMLLiveCollectionImp::~HTMLLiveCollectionImp()
+{
+    if (document)
+        document->removeLiveCollection(this);
+}
+
+bool HTMLLiveCollectionImp::match(ElementImp* element)
+{
+    if (type == TagName)
+        return name.empty() || element->getLocalNameAtom() == name;
+
+    if (classes.empty())
+        return false;
+    std::u16string c = element->getClassName();
+    std::vector<std::u16string> v;
+    boost::algorithm::split(v, c, isSpace);
+    for (auto i = classes.begin(); i != classes.end(); ++i) {
+        if (std::find(v.begin(), v.end(), *i) == v.end())
+            return false;
+    }
+    return true;
+}
+
+// Returns the element next to node in tree order within the descendants of root.
+ElementImp* HTMLLiveCollectionImp::next(NodeImp* node)
+{
+    for (;;) {
+        if (node->firstChild)
+            node = node->firstChild;
+        else {
+            while (node != root.get() && !node->nextSibling)
+                node = node->parentNode;
+            if (node == root.get())
+                return 0;
+            node = node->nextSibling;
+        }
+        if (node->getNodeType() == Node::ELEMENT_NODE)
+            return dynamic_cast<ElementImp*>(node);
+    }
+}
+
+void HTMLLiveCollectionImp::update()
+{
+    if (document && document->getDOMVersion() == version)
+        return;
+    if (document)
+        version = document->getDOMVersion();
+    elements.clear();
+    complete = false;
+}
+
+// Collects the elements up to index, resuming from the last one collected.
+bool HTMLLiveCollectionImp::fill(unsigned int index)
+{
+    update();
+    while (!complete && elements.size() <= index) {
+        NodeImp* node = elements.empty() ? root.get() : elements.back();
+        for (ElementImp* e = next(node);; e = next(e)) {
+            if (!e) {
+                complete = true;
+                break;
+            }
+            if (match(e)) {
+                elements.push_back(e);
+                break;
+            }
+        }
+    }
+    return index < elements.size();
+}
+
+unsigned int HTMLLiveCollectionImp::getLength()
+{
+    fill(static_cast<unsigned int>(-1));
+    return elements.size();
+}
+
+Element HTMLLiveCollectionImp::item(unsigned int index)
+{
+    if (!fill(index))
+        return 0;
+    return elements[index];
+}
+
+Object HTMLLiveCollectionImp::namedItem(const std::u16string& name)
+{
+    if (name.empty())
+        return 0;
+    fill(static_cast<unsigned int>(-1));
+    for (auto i = elements.begin(); i != elements.end(); ++i) {
+        ElementImp* e = *i;
+        if (e->getId() == name)
+            return e;
+        Nullable<std::u16string> uri = e->getNamespaceURI();
+        if (uri.hasValue() && uri.value() == u"http://www.w3.org/1999/xhtml") {
+            Nullable<std::u16string> n = e->getAttribute(u"name");
+            if (n.hasValue() && n.value() == name)
+                return e;
+        }
+    }
+    return 0;
+}
+
+}}}}  // org::w3c::dom::bootstrap
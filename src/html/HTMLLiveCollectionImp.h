@@ -0,0 +1,76 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ORG_W3C_DOM_BOOTSTRAP_HTMLLIVECOLLECTIONIMP_H_INCLUDED
+#define ORG_W3C_DOM_BOOTSTRAP_HTMLLIVECOLLECTIONIMP_H_INCLUDED
+
+#include "HTMLCollectionImp.h"
+
+#include <string>
+#include <vector>
+#include <boost/intrusive_ptr.hpp>
+
+#include "Atom.h"
+#include "NodeImp.h"
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+class DocumentImp;
+class ElementImp;
+
+// A live HTMLCollection of the descendant elements of root that match a tag
+// name or a set of class names. The elements are collected lazily, and the
+// collected ones are kept until the DOM version of the document changes.
+class HTMLLiveCollectionImp : public HTMLCollectionImp
+{
+    friend class DocumentImp;
+
+public:
+    enum Type {
+        TagName,
+        ClassName
+    };
+
+private:
+    boost::intrusive_ptr<NodeImp> root;
+    DocumentImp* document;  // cleared when the document is gone
+    int type;
+    std::u16string key;
+    Atom name;  // for TagName; empty for '*'
+    std::vector<std::u16string> classes;    // for ClassName
+
+    unsigned version;
+    std::vector<ElementImp*> elements;
+    bool complete;
+
+    bool match(ElementImp* element);
+    ElementImp* next(NodeImp* node);
+    void update();
+    bool fill(unsigned int index);
+
+public:
+    HTMLLiveCollectionImp(NodeImp* root, DocumentImp* document, int type, const std::u16string& key);
+    ~HTMLLiveCollectionImp();
+
+    // HTMLCollection
+    virtual unsigned int getLength();
+    virtual Element item(unsigned int index);
+    virtual Object namedItem(const std::u16string& name);
+};
+
+}}}}  // org::w3c::dom::bootstrap
+
+#endif  // ORG_W3C_DOM_BOOTSTRAP_HTMLLIVECOLLECTIONIMP_H_INCLUDED
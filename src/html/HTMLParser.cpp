@@ -1171,9 +1171,7 @@ bool HTMLParser::InBody::processStartTag(HTMLParser* parser, Token& token)
             processEndTag(parser, endTagP);
         parser->insertHtmlElement(token);
         parser->framesetOkFlag = false;
-        Token token = parser->tokenizer->getToken();
-        if (token.getType() != Token::Type::Character || token.getChar() != '\n')
-            parser->processToken(token);
+        parser->skipLineFeed = true;
         return true;
     }
     if (token.getName() == u"form") {
@@ -1336,9 +1334,7 @@ bool HTMLParser::InBody::processStartTag(HTMLParser* parser, Token& token)
     if (token.getName() == u"textarea") {
         parser->insertHtmlElement(token);
         parser->tokenizer->setState(&HTMLTokenizer::rcdataState);
-        Token nextToken = parser->tokenizer->peekToken();
-        if (nextToken.getType() == Token::Type::Character && nextToken.getChar() == '\n')
-            parser->tokenizer->getToken();
+        parser->skipLineFeed = true;
         parser->originalInsertionMode = parser->insertionMode;
         parser->framesetOkFlag = false;
         parser->setInsertionMode(&parser->text);
@@ -2899,6 +2895,7 @@ HTMLParser::HTMLParser(Document document, HTMLTokenizer* tokenizer, bool enableX
     formElement(0),
     scriptingFlag(true),
     framesetOkFlag(false),
+    skipLineFeed(false),
     insertFromTable(false),
     innerHTML(false),
     enableXBL(enableXBL),
@@ -2908,9 +2905,51 @@ HTMLParser::HTMLParser(Document document, HTMLTokenizer* tokenizer, bool enableX
 
 bool HTMLParser::processToken(Token& token)
 {
+    if (token.getType() == Token::Type::Characters)
+        return processCharacters(token);
+    if (skipLineFeed && token.getType() != Token::Type::ParseError) {
+        skipLineFeed = false;
+        if (token.getType() == Token::Type::Character && token.getChar() == '\n')
+            return true;
+    }
     return insertionMode->processToken(this, token);
 }
 
+// Processes a run of characters containing neither NUL nor CR at once in
+// the common insertion modes, and one by one otherwise.
+bool HTMLParser::processCharacters(Token& token)
+{
+    const std::u16string& data(token.getName());
+    size_t pos = 0;
+    if (skipLineFeed) {
+        skipLineFeed = false;
+        if (!data.empty() && data[0] == '\n')
+            pos = 1;
+    }
+    if (data.length() <= pos)
+        return true;
+    if (insertionMode == &text) {
+        text.insertCharacters(data, pos);
+        return true;
+    }
+    if (insertionMode == &inBody) {
+        reconstructActiveFormattingElements();
+        insertCharacter(pos ? data.substr(pos) : data);
+        for (auto i = data.begin() + pos; i != data.end(); ++i) {
+            if (!isSpace(*i)) {
+                framesetOkFlag = false;
+                break;
+            }
+        }
+        return true;
+    }
+    for (; pos < data.length(); ++pos) {
+        Token c(data[pos]);
+        insertionMode->processToken(this, c);
+    }
+    return true;
+}
+
 void HTMLParser::mainLoop()
 {
     Token token;
@@ -177,6 +177,9 @@ class HTMLParser
         void commitPendingCharacters(HTMLParser* parser);
 
     public:
+        void insertCharacters(const std::u16string& data, size_t pos) {
+            pendingCharacters.append(data, pos, std::u16string::npos);
+        }
         virtual bool processEOF(HTMLParser* parser, Token& token);
         virtual bool processComment(HTMLParser* parser, Token& token);
         virtual bool processDoctype(HTMLParser* parser, Token& token);
@@ -564,6 +567,7 @@ class HTMLParser
 
     bool scriptingFlag;
     bool framesetOkFlag;
+    bool skipLineFeed;  // true to ignore the next LF token, e.g., right after <pre>
     bool insertFromTable;
 
     bool innerHTML;   // true if this parser was originally created as part of the HTML fragment parsing algorithm
@@ -576,6 +580,8 @@ class HTMLParser
 
     bool stopParsing();
 
+    bool processCharacters(Token& token);
+
 public:
     HTMLParser(Document document, HTMLTokenizer* tokenizer, bool enableXBL = true);
     void mainLoop();
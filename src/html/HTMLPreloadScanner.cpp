@@ -0,0 +1,280 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HTMLPreloadScanner.h"
+
+#include <string.h>
+#include <strings.h>
+
+#include "http/HTTPRequest.h"
+#include "url/URL.h"
+#include "utf.h"
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+HTMLPreloadScanner::HTMLPreloadScanner(const DocumentWindowPtr& window, const std::u16string& base) :
+    window(window),
+    base(base),
+    baseFound(false),
+    state(Data)
+{
+}
+
+size_t HTMLPreloadScanner::findTagEnd(const std::string& s, size_t pos)
+{
+    char quote = 0;
+    char prev = 0;
+    for (; pos < s.length(); ++pos) {
+        char c = s[pos];
+        if (quote) {
+            if (c == quote)
+                quote = 0;
+        } else if (c == '>')
+            return pos;
+        else if ((c == '"' || c == '\'') && prev == '=')
+            quote = c;
+        if (!isSpace(c))
+            prev = c;
+    }
+    return std::string::npos;
+}
+
+size_t HTMLPreloadScanner::findEndTag(const std::string& s, const std::string& tag, size_t pos)
+{
+    for (; pos + tag.length() <= s.length(); ++pos) {
+        if (s[pos] == '<' && strncasecmp(s.c_str() + pos, tag.c_str(), tag.length()) == 0)
+            return pos;
+    }
+    return std::string::npos;
+}
+
+// Note the attribute value is not lowercased unlike HTMLInputStream::getAttr().
+const char* HTMLPreloadScanner::getAttr(const char* p, std::string& name, std::string& value)
+{
+    name = value = "";
+
+    p += strspn(p, "\t\n\f\r /");
+    if (!*p)
+        return p;
+
+    // Attribute name:
+    for (;;) {
+        if (!*p)
+            return p;
+        if ((*p == '=' && 0 < name.length()) || strchr("\t\n\f\r ", *p))
+            break;
+        if (*p == '/')
+            return p;
+        name += tolower(*p);
+        ++p;
+    }
+
+    p += strspn(p, "\t\n\f\r ");
+    if (*p != '=')
+        return p;
+    ++p;
+
+    // Attribute value:
+    p += strspn(p, "\t\n\f\r ");
+    if (*p == '\'' || *p == '"') {
+        char b = *p;
+        ++p;
+        while (*p && *p != b) {
+            value += *p;
+            ++p;
+        }
+        if (*p == b)
+            ++p;
+        return p;
+    }
+    while (*p && !strchr("\t\n\f\r ", *p)) {
+        value += *p;
+        ++p;
+    }
+    return p;
+}
+
+void HTMLPreloadScanner::handleTag(const char* p)
+{
+    std::string tag;
+    while (*p && !strchr("\t\n\f\r /", *p)) {
+        tag += tolower(*p);
+        ++p;
+    }
+
+    std::string src;
+    std::string href;
+    std::string rel;
+    std::string name;
+    std::string value;
+    for (;;) {
+        p = getAttr(p, name, value);
+        if (name.empty())
+            break;
+        if (name == "src") {
+            if (src.empty())
+                src = value;
+        } else if (name == "href") {
+            if (href.empty())
+                href = value;
+        } else if (name == "rel") {
+            if (rel.empty())
+                rel = value;
+        }
+    }
+
+    if (tag == "script") {
+        preload(src, HttpRequest::BLOCKING_PRIORITY);
+        state = RawText;
+        rawTextEnd = "</script";
+    } else if (tag == "img")
+        preload(src, HttpRequest::LOW_PRIORITY);
+    else if (tag == "link") {
+        // cf. http://www.whatwg.org/specs/web-apps/current-work/multipage/links.html#link-type-stylesheet
+        bool stylesheet = false;
+        bool alternate = false;
+        bool preconnect = false;
+        bool dnsPrefetch = false;
+        for (const char* r = rel.c_str(); *r; ) {
+            r += strspn(r, "\t\n\f\r ");
+            size_t length = strcspn(r, "\t\n\f\r ");
+            if (length == 10 && strncasecmp(r, "stylesheet", 10) == 0)
+                stylesheet = true;
+            else if (length == 9 && strncasecmp(r, "alternate", 9) == 0)
+                alternate = true;
+            else if (length == 10 && strncasecmp(r, "preconnect", 10) == 0)
+                preconnect = true;
+            else if (length == 12 && strncasecmp(r, "dns-prefetch", 12) == 0)
+                dnsPrefetch = true;
+            r += length;
+        }
+        if (stylesheet && !alternate)
+            preload(href, HttpRequest::BLOCKING_PRIORITY);
+        else if (preconnect || dnsPrefetch) {
+            // cf. http://www.w3.org/TR/resource-hints/
+            std::string url = getURL(href);
+            if (!url.empty())
+                window->preconnect(base, utfconv(url), preconnect);
+        }
+    } else if (tag == "base") {
+        // Only the first base element with an href attribute counts.
+        if (!baseFound && !href.empty()) {
+            baseFound = true;
+            URL url(base, utfconv(href));
+            if (!url.isEmpty())
+                base = url;
+        }
+    } else if (tag == "style" || tag == "textarea" || tag == "title" || tag == "xmp" ||
+               tag == "iframe" || tag == "noembed" || tag == "noframes") {
+        state = RawText;
+        rawTextEnd = "</" + tag;
+    }
+}
+
+// Returns the attribute value with leading and trailing white space removed,
+// or an empty string if it cannot be handled here.
+std::string HTMLPreloadScanner::getURL(const std::string& url)
+{
+    size_t begin = url.find_first_not_of("\t\n\f\r ");
+    if (begin == std::string::npos)
+        return "";
+    size_t end = url.find_last_not_of("\t\n\f\r ");
+    std::string s;
+    for (size_t i = begin; i <= end; ++i) {
+        // Leave URLs with non-ASCII characters to the tree builder since
+        // the character encoding of the document is unknown here.
+        if (url[i] & 0x80)
+            return "";
+        s += url[i];
+        if (url[i] == '&' && url.compare(i, 5, "&amp;") == 0)
+            i += 4;
+    }
+    return s;
+}
+
+void HTMLPreloadScanner::preload(const std::string& url, unsigned short priority)
+{
+    std::string s = getURL(url);
+    if (!s.empty())
+        window->preload(base, utfconv(s), priority);
+}
+
+void HTMLPreloadScanner::scan(const char* data, size_t length)
+{
+    if (!window)
+        return;
+    buffer.append(data, length);
+    size_t pos = 0;
+    while (pos < buffer.length()) {
+        if (state == Comment) {
+            size_t end = buffer.find("-->", pos);
+            if (end == std::string::npos) {
+                if (2 < buffer.length() - pos)
+                    pos = buffer.length() - 2;
+                break;
+            }
+            pos = end + 3;
+            state = Data;
+            continue;
+        }
+        if (state == RawText) {
+            size_t end = findEndTag(buffer, rawTextEnd, pos);
+            if (end == std::string::npos) {
+                if (rawTextEnd.length() < buffer.length() - pos)
+                    pos = buffer.length() - rawTextEnd.length();
+                break;
+            }
+            pos = end + rawTextEnd.length();
+            state = Data;
+            continue;
+        }
+
+        size_t lt = buffer.find('<', pos);
+        if (lt == std::string::npos) {
+            pos = buffer.length();
+            break;
+        }
+        if (buffer.length() < lt + 4) {
+            pos = lt;  // wait for more octets to tell comments from tags
+            break;
+        }
+        if (buffer.compare(lt, 4, "<!--") == 0) {
+            pos = lt + 4;
+            state = Comment;
+            continue;
+        }
+        char c = buffer[lt + 1];
+        if (!isAlpha(c) && c != '!' && c != '/' && c != '?') {
+            pos = lt + 1;
+            continue;
+        }
+        size_t end = findTagEnd(buffer, lt + 1);
+        if (end == std::string::npos) {
+            if (MaxTagLength < buffer.length() - lt) {
+                pos = lt + 1;  // give up on this tag
+                continue;
+            }
+            pos = lt;
+            break;
+        }
+        if (isAlpha(c))
+            handleTag(buffer.substr(lt + 1, end - lt - 1).c_str());
+        pos = end + 1;
+    }
+    buffer.erase(0, pos);
+}
+
+}}}}  // org::w3c::dom::bootstrap
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES_HTMLPRELOADSCANNER_H
+#define ES_HTMLPRELOADSCANNER_H
+
+#include <string>
+
+#include "DocumentWindow.h"
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+// HTMLPreloadScanner looks ahead of the tree builder over the undecoded
+// input and starts fetching the style sheets, scripts, and images that
+// the document is going to need. It assumes an ASCII compatible encoding.
+class HTMLPreloadScanner
+{
+    static const size_t MaxTagLength = 4096;
+
+    enum {
+        Data,
+        Comment,
+        RawText
+    };
+
+    DocumentWindowPtr window;
+    std::u16string base;
+    bool baseFound;
+    int state;
+    std::string rawTextEnd;  // e.g., "</script" in the RawText state
+    std::string buffer;      // the octets yet to be scanned
+
+    static size_t findTagEnd(const std::string& s, size_t pos);
+    static size_t findEndTag(const std::string& s, const std::string& tag, size_t pos);
+    static const char* getAttr(const char* p, std::string& name, std::string& value);
+    static std::string getURL(const std::string& url);
+
+    void handleTag(const char* p);
+    void preload(const std::string& url, unsigned short priority);
+
+public:
+    HTMLPreloadScanner(const DocumentWindowPtr& window, const std::u16string& base);
+
+    void scan(const char* data, size_t length);
+};
+
+}}}}  // org::w3c::dom::bootstrap
+
+#endif  // ES_HTMLPRELOADSCANNER_H
@@ -20,8 +20,6 @@
 
 #include <boost/bind.hpp>
 #include <boost/version.hpp>
-#include <boost/iostreams/stream.hpp>
-#include <boost/iostreams/device/file_descriptor.hpp>
 
 #include "ECMAScript.h"
 
@@ -29,6 +27,7 @@
 #include "DocumentImp.h"
 #include "DocumentWindow.h"
 #include "U16InputStream.h"
+#include "http/HTTPContentStream.h"
 
 #include "HTMLBindingElementImp.h"
 
@@ -97,6 +96,7 @@ bool HTMLScriptElementImp::prepare()
         request = new(std::nothrow) HttpRequest(document->getDocumentURI());
         if (request) {
             request->open(u"GET", src);
+            request->setPriority(HttpRequest::BLOCKING_PRIORITY);
             request->setHandler(boost::bind(&HTMLScriptElementImp::notify, this));
             document->incrementLoadEventDelayCount();
             if (hasDefer && parserInserted && !hasAsync) {
@@ -168,7 +168,7 @@ bool HTMLScriptElementImp::execute()
     std::u16string script;
     if (request) {
         assert(request->getStatus() == 200);
-        boost::iostreams::stream<boost::iostreams::file_descriptor_source> stream(request->getContentDescriptor(), boost::iostreams::close_handle);
+        HttpContentStream stream(*request);
         U16ConverterInputStream u16stream(stream, "utf-8");  // TODO detect encode
         script = u16stream;
     } else {
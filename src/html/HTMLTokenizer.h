@@ -18,15 +18,14 @@
 #define ES_HTMLTOKENIZER_H
 
 #include <Object.h>
-#include <org/w3c/dom/Attr.h>
 #include <org/w3c/dom/Element.h>
 
 #include <deque>
 #include <iostream>
 #include <queue>
-#include <set>
 #include <stack>
 #include <string>
+#include <vector>
 
 #include "U16InputStream.h"
 
@@ -50,6 +49,11 @@ public:
         return name;
     }
 
+    std::u16string& getValue()
+    {
+        return value;
+    }
+
     const std::u16string& getValue() const
     {
         return value;
@@ -64,8 +68,6 @@ public:
 
 class Token
 {
-    typedef org::w3c::dom::Attr Attr;
-
 public:
     enum class Type
     {
@@ -75,6 +77,7 @@ public:
         Doctype,
         ParseError,
         Character,
+        Characters, // a run of characters in name
         EndOfFile
     };
 
@@ -97,9 +100,9 @@ private:
     // name or data for Comment and Doctype
     std::u16string name;
 
-    // StartTag/EndTag field
-    std::set<std::u16string> attrNames;
-    std::deque<Attr> attrList;
+    // StartTag/EndTag field; tags seldom have more than a few attributes,
+    // so duplicates are found by a linear search.
+    std::vector<Attribute> attrList;
 
     // Doctype fields
     std::u16string publicId;
@@ -130,7 +133,7 @@ public:
         this->name = name;
     }
 
-    const std::deque<Attr>& getAttributes() const
+    const std::vector<Attribute>& getAttributes() const
     {
         return attrList;
     }
@@ -213,6 +216,10 @@ public:
 
 class HTMLTokenizer
 {
+    // The maximum number of characters a state could consume at once while
+    // looking ahead, e.g., for a named character reference.
+    static const size_t MaxLookAhead = 80;
+
     class State
     {
     public:
@@ -221,36 +228,47 @@ class HTMLTokenizer
         {
             return false;
         }
+        // Consume a run of characters that need no special handling at
+        // once. Return false if there's no such character to consume.
+        virtual bool scan(HTMLTokenizer* tokenizer)
+        {
+            return false;
+        }
     };
 
     class DataState : public State
     {
     public:
         bool consume(HTMLTokenizer* tokenizer, int ch);
+        bool scan(HTMLTokenizer* tokenizer);
     };
 
     class RcdataState : public State
     {
     public:
         bool consume(HTMLTokenizer* tokenizer, int ch);
+        bool scan(HTMLTokenizer* tokenizer);
     };
 
     class RawtextState : public State
     {
     public:
         bool consume(HTMLTokenizer* tokenizer, int ch);
+        bool scan(HTMLTokenizer* tokenizer);
     };
 
     class ScriptDataState : public State
     {
     public:
         bool consume(HTMLTokenizer* tokenizer, int ch);
+        bool scan(HTMLTokenizer* tokenizer);
     };
 
     class PlaintextState : public State
     {
     public:
         bool consume(HTMLTokenizer* tokenizer, int ch);
+        bool scan(HTMLTokenizer* tokenizer);
     };
 
     class TagOpenState : public State
@@ -437,12 +455,14 @@ class HTMLTokenizer
     {
     public:
         bool consume(HTMLTokenizer* tokenizer, int ch);
+        bool scan(HTMLTokenizer* tokenizer);
     };
 
     class AttributeValueSingleQuotedState : public State
     {
     public:
         bool consume(HTMLTokenizer* tokenizer, int ch);
+        bool scan(HTMLTokenizer* tokenizer);
     };
 
     class AttributeValueUnquotedState : public State
@@ -723,6 +743,11 @@ class HTMLTokenizer
         return stream->get();
     }
 
+    bool readRun(std::u16string& text, char16_t stop1, char16_t stop2)
+    {
+        return charStack.empty() && stream->readRun(text, stop1, stop2);
+    }
+
     int peekChar()
     {
         if (!charStack.empty())
@@ -748,6 +773,7 @@ class HTMLTokenizer
 
     bool emit(int ch);
     bool emit(const std::u16string& s);
+    bool emitRun(const std::u16string& s);
     bool emit(const Token& tag);
 
     bool isAppropriate(const std::u16string& name) {
@@ -765,6 +791,10 @@ public:
     Token peekToken();
     Token getToken();
 
+    // Returns true if the next token can be read without running out of
+    // the input available so far.
+    bool isReady();
+
     void insertString(const std::u16string& s);
 
     void setContext(org::w3c::dom::Element context);
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HTMLTokenizerThread.h"
+
+#include <chrono>
+
+#include "html/HTMLUtil.h"
+
+HTMLTokenizerThread::HTMLTokenizerThread(HTMLTokenizer* tokenizer, U16ConverterInputStream* stream, unsigned long long available, bool complete) :
+    tokenizer(tokenizer),
+    stream(stream),
+    head(0),
+    tail(0),
+    current(0),
+    next(0),
+    blocked(false),
+    flags(Update),  // start tokenizing what is available already
+    available(available),
+    complete(complete),
+    busy(true),
+    waiting(false),
+    expecting(false),
+    aborted(false)
+{
+    // Detect the character encoding before the worker starts.
+    if (complete)
+        stream->setComplete();
+    else
+        stream->setAvailable(available);
+    encoding = stream->getEncoding();
+    thread = std::thread(&HTMLTokenizerThread::run, this);
+}
+
+HTMLTokenizerThread::~HTMLTokenizerThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        aborted = true;
+        flags |= Abort;
+        cond.notify_one();
+    }
+    thread.join();
+    delete current;
+    for (size_t i = head; i != tail; ++i)
+        delete queue[i % QueueSize];
+}
+
+// Returns true if the tree builder might change the tokenizer state, or
+// a script might insert text into the input, while processing the token.
+bool HTMLTokenizerThread::isSynchronizationPoint(const Token& token)
+{
+    switch (token.getType()) {
+    case Token::Type::StartTag:
+        return 0 <= findKeyword(token.getName(), {
+            u"iframe", u"implementation", u"noembed", u"noframes", u"noscript", u"plaintext",
+            u"script", u"style", u"textarea", u"title", u"xmp"
+        });
+    case Token::Type::EndTag:
+        return 0 <= findKeyword(token.getName(), { u"implementation", u"script" });
+    default:
+        return false;
+    }
+}
+
+// Records the encoding of the input, which may have been changed while
+// tokenizing, before the main thread could take over the tokenizer.
+void HTMLTokenizerThread::updateEncoding()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    encoding = stream->getEncoding();
+}
+
+unsigned HTMLTokenizerThread::sleep(unsigned long long& length, bool& eof)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!flags) {
+        busy = false;
+        tokenCond.notify_one();
+        cond.wait(lock);
+    }
+    unsigned result = flags;
+    flags = 0;
+    length = available;
+    eof = complete;
+    return result;
+}
+
+void HTMLTokenizerThread::wakeUp(unsigned flags)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    this->flags |= flags;
+    busy = true;
+    cond.notify_one();
+}
+
+// Appends the batch to the queue; waits while the queue is full. Returns
+// false if aborted.
+bool HTMLTokenizerThread::push(Batch* batch)
+{
+    updateEncoding();
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) == QueueSize) {
+        std::unique_lock<std::mutex> lock(mutex);
+        waiting = true;
+        while (t - head.load() == QueueSize && !aborted)
+            cond.wait(lock);
+        waiting = false;
+        if (aborted) {
+            delete batch;
+            return false;
+        }
+    }
+    queue[t % QueueSize] = batch;
+    tail.store(t + 1);  // paired with expecting in wait()
+    if (expecting) {
+        std::lock_guard<std::mutex> lock(mutex);
+        tokenCond.notify_one();
+    }
+    return true;
+}
+
+void HTMLTokenizerThread::run()
+{
+    bool blocking = false;  // true while stopped at a synchronization point
+    bool done = false;      // true once the end-of-file token has been emitted
+    for (;;) {
+        unsigned long long length;
+        bool eof;
+        unsigned command = sleep(length, eof);
+        if (command & Abort)
+            break;
+        if (command & Resume)
+            blocking = false;
+        if (blocking || done)
+            continue;   // the stream is updated once resumed
+        if (eof)
+            stream->setComplete();
+        else
+            stream->setAvailable(length);
+
+        Batch* batch = 0;
+        while (!aborted && tokenizer->isReady()) {
+            if (!batch) {
+                batch = new Batch;
+                batch->tokens.reserve(BatchSize);
+            }
+            batch->tokens.push_back(tokenizer->getToken());
+            const Token& token(batch->tokens.back());
+            if (token.getType() == Token::Type::EndOfFile)
+                done = true;
+            else if (isSynchronizationPoint(token))
+                blocking = batch->blocking = true;
+            if (done || blocking || BatchSize <= batch->tokens.size()) {
+                Batch* full = batch;
+                batch = 0;
+                if (!push(full) || done || blocking)
+                    break;
+            }
+        }
+        // Hand over what has been tokenized from the input available so far.
+        if (batch && !push(batch))
+            break;
+        if (!blocking)
+            updateEncoding();
+    }
+}
+
+void HTMLTokenizerThread::update(unsigned long long available, bool complete)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (this->available == available && this->complete == complete)
+        return;
+    this->available = available;
+    this->complete = complete;
+    flags |= Update;
+    busy = true;
+    cond.notify_one();
+}
+
+bool HTMLTokenizerThread::isReady()
+{
+    if (current) {
+        if (next < current->tokens.size())
+            return true;
+        blocked = current->blocking;
+        delete current;
+        current = 0;
+    }
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire)) {
+        if (blocked) {
+            // The token at the synchronization point has been processed.
+            blocked = false;
+            wakeUp(Resume);
+        }
+        return false;
+    }
+    current = queue[h % QueueSize];
+    next = 0;
+    head.store(h + 1);  // paired with waiting in push()
+    if (waiting) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cond.notify_one();
+    }
+    return true;
+}
+
+bool HTMLTokenizerThread::wait(unsigned milliseconds)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    expecting = true;
+    tokenCond.wait_for(lock, std::chrono::milliseconds(milliseconds), [this] {
+        return head.load() != tail.load() || !busy;
+    });
+    expecting = false;
+    return head.load() != tail.load();
+}
+
+Token HTMLTokenizerThread::getToken()
+{
+    return std::move(current->tokens[next++]);
+}
+
+std::string HTMLTokenizerThread::getEncoding()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return encoding;
+}
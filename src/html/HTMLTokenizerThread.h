@@ -0,0 +1,123 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES_HTMLTOKENIZERTHREAD_H
+#define ES_HTMLTOKENIZERTHREAD_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "HTMLTokenizer.h"
+
+// HTMLTokenizerThread runs an HTMLTokenizer on a worker thread and hands
+// the tokens over to the tree builder on the main thread in batches
+// through a single-producer single-consumer queue.
+//
+// The tree builder switches the tokenizer state after some start tags,
+// and a script run at </script> may insert text with document.write().
+// The worker therefore stops right after emitting such a token, and
+// resumes only after the main thread has processed it. While the worker
+// is stopped, the main thread can access the tokenizer and its input
+// stream directly; the worker applies the input updates received in the
+// meantime after it resumes.
+class HTMLTokenizerThread
+{
+    static const size_t BatchSize = 256;    // tokens
+    static const size_t QueueSize = 64;     // batches; a power of two
+
+    struct Batch
+    {
+        std::vector<Token> tokens;
+        bool blocking;  // true if the last token is a synchronization point
+        Batch() :
+            blocking(false)
+        {
+        }
+    };
+
+    enum {
+        Update = 1,
+        Resume = 2,
+        Abort = 4
+    };
+
+    HTMLTokenizer* tokenizer;
+    U16ConverterInputStream* stream;
+
+    // The queue of the batches; the worker writes tail and the main thread
+    // writes head.
+    Batch* queue[QueueSize];
+    std::atomic_size_t head;
+    std::atomic_size_t tail;
+
+    // Owned by the main thread
+    Batch* current;
+    size_t next;        // the index of the next token in current
+    bool blocked;       // true if the worker has stopped at the last token taken
+
+    // Guarded by mutex
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::condition_variable tokenCond;  // for the main thread waiting for tokens
+    unsigned flags;
+    unsigned long long available;
+    bool complete;
+    std::string encoding;
+    std::atomic_bool busy;      // true while the worker has something to do
+    std::atomic_bool waiting;   // true while the worker waits for the queue to be drained
+    std::atomic_bool expecting; // true while the main thread waits for tokens
+    std::atomic_bool aborted;
+
+    std::thread thread;
+
+    static bool isSynchronizationPoint(const Token& token);
+
+    void updateEncoding();
+    unsigned sleep(unsigned long long& length, bool& eof);
+    void wakeUp(unsigned flags);
+    bool push(Batch* batch);
+    void run();
+
+public:
+    HTMLTokenizerThread(HTMLTokenizer* tokenizer, U16ConverterInputStream* stream, unsigned long long available, bool complete);
+    ~HTMLTokenizerThread();
+
+    // Tells the worker how much of the input has been downloaded.
+    void update(unsigned long long available, bool complete);
+
+    // Returns true if a token can be taken by getToken(). If the worker has
+    // stopped at the token processed last, lets the worker continue; call
+    // this only when no parser-blocking script is pending.
+    bool isReady();
+    Token getToken();
+
+    // Returns true if the worker is tokenizing the input, i.e., more tokens
+    // are expected to be ready without waiting for the network.
+    bool isBusy() const {
+        return busy;
+    }
+    // Waits up to the specified time while the worker is tokenizing the
+    // input. Returns true if a token has become ready.
+    bool wait(unsigned milliseconds);
+
+    std::string getEncoding();
+};
+
+#endif  // ES_HTMLTOKENIZERTHREAD_H
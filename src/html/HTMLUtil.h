@@ -102,6 +102,11 @@ bool mapToInteger(std::u16string& value);
 bool mapToPixelLength(std::u16string& value);
 bool mapToDimension(std::u16string& value);
 
+// Returns the length of the longest named character reference at the start
+// of the zero-terminated name and sets its code point to unicode. Returns
+// zero if there is none. cf. HTMLEntities.re
+size_t HTMLMatchEntity(const char* name, char32_t& unicode);
+
 }
 }
 }
@@ -17,9 +17,16 @@
 #include "HTTPCache.h"
 
 #include <assert.h>
+#include <dirent.h>
+#include <sys/stat.h>
 #include <time.h>
+#include <unistd.h>
 
 #include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
 
 #include "url/URI.h"
 #include "http/HTTPConnection.h"
@@ -31,25 +38,44 @@
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
+HttpCache::~HttpCache()
+{
+    if (!filePath.empty())
+        HttpCacheManager::getInstance().removeFile(filePath);
+}
+
 void HttpCache::notify(HttpRequest* request, bool error)
 {
     current = 0;
 
-    if (error)
+    if (error) {
+        if (keepPartial(request)) {
+            // Let the next request resume the content.
+            if (!requests.empty()) {
+                request = requests.front();
+                requests.pop_front();
+                send(request);
+            }
+            return;
+        }
         invalidate();
-    else {
+    } else {
+        range = false;
         response.update(request->getResponseMessage());
-        // TODO: deal with partial...
         unsigned short status = request->getResponseMessage().getStatus();
         if (status == 304) {  // Not Modified?
             request->removeFile();
             request->constructResponseFromCache(false);
         } else {
             if (!filePath.empty() && filePath != request->getFilePath())
-                remove(filePath.c_str());
+                HttpCacheManager::getInstance().removeFile(filePath);
             response.updateStatus(request->getResponseMessage());
             filePath = request->getFilePath();
+            request->pinFile();
+            buffer = request->getContentBuffer();
+            span = request->getContentSpan();
         }
+        HttpCacheManager::getInstance().update(this);
     }
 
     while (!requests.empty()) {
@@ -68,17 +94,60 @@ void HttpCache::notify(HttpRequest* request, bool error)
     delete this;
 }
 
+// Keeps the content of the interrupted response received so far so that
+// the rest can be requested later with If-Range.
+// cf. http://tools.ietf.org/html/draft-ietf-httpbis-p6-cache-22#section-3.1
+bool HttpCache::keepPartial(HttpRequest* request)
+{
+    const HttpResponseMessage& partial(request->resumeResponse);
+    unsigned long long length = request->getContentOctetCount();
+    if (range && length == 0)
+        return true;    // failed before resuming; keep the current one
+    std::string coding = partial.getResponseHeader(HttpHeader::ContentEncoding);
+    if (request->getRequestMessage().getMethodCode() != HttpRequestMessage::GET ||
+        partial.getStatus() != 200 || !partial.hasContentLengthHeader() ||
+        length == 0 || partial.getContentLength() <= length ||
+        (!coding.empty() && coding != "identity") ||
+        !partial.isCacheable() || partial.isNoStore() || partial.getRangeValidator().empty() ||
+        request->getFilePath().empty() || request->getContentBuffer())
+        return false;
+
+    if (!filePath.empty() && filePath != request->getFilePath())
+        HttpCacheManager::getInstance().removeFile(filePath);
+    response = partial;
+    filePath = request->getFilePath();
+    buffer.reset();
+    span.clear();
+    range = true;
+    HttpCacheManager::getInstance().update(this);
+    return true;
+}
+
 void HttpCache::invalidate()
 {
     response.clear();
     contentLength = 0;
+    range = false;
     if (!filePath.empty()) {
-        remove(filePath.c_str());
+        HttpCacheManager::getInstance().removeFile(filePath);
         filePath.clear();
     }
+    buffer.reset();
+    span.clear();
     requestTime = 0;
 }
 
+const HttpContentSpan& HttpCache::getContentSpan()
+{
+    if (!span.isValid()) {
+        if (buffer)
+            span = HttpContentSpan(buffer);
+        else if (!filePath.empty())
+            span = HttpContentSpan::map(filePath);
+    }
+    return span;
+}
+
 HttpCache* HttpCache::send(HttpRequest* request)
 {
     if (current) {
@@ -87,24 +156,32 @@ HttpCache* HttpCache::send(HttpRequest* request)
     }
     current = request;
 
+    HttpRequestMessage& requestMessage(request->getRequestMessage());
     if (!requestTime)
         requestTime = time(0);
-    else {
+    else if (range) {
+        // Request the rest of the partial content.
+        requestTime = time(0);
+        requestMessage.setHeader("Range", "bytes=" + std::to_string(contentLength) + "-");
+        requestMessage.setHeader("If-Range", response.getRangeValidator());
+        requestMessage.setHeader("Accept-Encoding", "identity");
+        request->resumeOffset = contentLength;
+        request->resumeResponse = response;
+        request->resumePath = filePath;
+    } else {
         // Validate
         // by If-Modified-Since
-        HttpRequestMessage& requestMessage(request->getRequestMessage());
-        std::string lastModified = response.getResponseHeader("Last-Modified");
-        if (!lastModified.empty()) {
+        long long lastModifiedValue;
+        if (response.getLastModifiedValue(lastModifiedValue)) {
             // Use only strong validator here
             long long date = response.getDateValue();
             if (date == 0)
                 date = requestTime;
-            long long lastModifiedValue;
-            if (response.getLastModifiedValue(lastModifiedValue) && 60 <= date - lastModifiedValue)
-                requestMessage.setHeader("If-Modified-Since", lastModified);
+            if (60 <= date - lastModifiedValue)
+                requestMessage.setHeader("If-Modified-Since", response.getResponseHeader(HttpHeader::LastModified));
         }
         // by If-None-Match
-        std::string value = response.getResponseHeader("ETag");
+        std::string value = response.getResponseHeader(HttpHeader::ETag);
         if (!value.empty())
             requestMessage.setHeader("If-None-Match", value);
     }
@@ -122,19 +199,272 @@ bool HttpCache::abort(HttpRequest* request)
     return false;
 }
 
-HttpCache* HttpCacheManager::getCache(const URL& url)
+// The index of the persistent cache is a journal of records, each of which
+// is either "P <length>\n<entry>\n" to put an entry, or "D <length>\n<url>\n"
+// to delete one. An entry consists of the URL, the file name, the request
+// time, the content length, and the response head, separated by LF. A
+// truncated record at the end is ignored. Each record is synced to the disk
+// as it is appended. The index is compacted at startup and at exit by
+// writing a new file and renaming it.
+
+void HttpCacheManager::setPersistent(const std::string& directory, unsigned long long budget)
 {
-    for (auto i = lru.begin(); i != lru.end(); ++i) {
-        HttpCache* cache = *i;
-        if (cache->url == url) {
-            lru.erase(i);
-            lru.push_front(cache);
-            return cache;
+    if (loaded)
+        return;
+    path = directory;
+    this->budget = budget;
+    // Load the index now, before any request creates its temporary file in
+    // the directory, since the files not in the index are removed.
+    load();
+}
+
+void HttpCacheManager::setLimits(size_t maxEntries, unsigned long long budget)
+{
+    this->maxEntries = maxEntries;
+    this->budget = budget;
+    if (loaded)
+        evict();
+}
+
+// The fragment identifier is never sent to the server.
+std::u16string HttpCacheManager::getKey(const URL& url)
+{
+    const std::u16string& s(url);
+    return s.substr(0, s.length() - url.getHash().length());
+}
+
+HttpCache* HttpCacheManager::insert(const URL& url)
+{
+    HttpCache* cache = new(std::nothrow) HttpCache(url);
+    if (!cache)
+        return 0;
+    std::pair<std::unordered_map<std::u16string, HttpCache*>::iterator, bool> result;
+    try {
+        result = index.insert(std::make_pair(getKey(url), cache));
+    } catch (...) {
+        delete cache;
+        return 0;
+    }
+    if (!result.second) {
+        // Replace the older entry of the same URL.
+        HttpCache* old = result.first->second;
+        lru.erase(old->position);
+        totalSize -= old->contentLength;
+        delete old;
+        result.first->second = cache;
+    }
+    lru.push_front(cache);
+    cache->position = lru.begin();
+    return cache;
+}
+
+void HttpCacheManager::erase(HttpCache* cache)
+{
+    auto found = index.find(getKey(cache->url));
+    if (found != index.end() && found->second == cache)
+        index.erase(found);
+    lru.erase(cache->position);
+    totalSize -= cache->contentLength;
+}
+
+bool HttpCacheManager::isStored(HttpCache* cache) const
+{
+    if (path.empty() || cache->filePath.empty() || cache->range)
+        return false;
+    if (cache->filePath.compare(0, path.length() + 1, path + '/') != 0)
+        return false;
+    const HttpResponseMessage& response(cache->response);
+    return response.isCacheable() && !response.isNoStore();
+}
+
+std::string HttpCacheManager::getRecord(HttpCache* cache) const
+{
+    std::ostringstream record;
+    record << utfconv(cache->url) << '\n' <<
+              cache->filePath.substr(path.length() + 1) << '\n' <<
+              cache->requestTime << '\n' <<
+              cache->contentLength << '\n' <<
+              cache->response.toString() << "\r\n";
+    return record.str();
+}
+
+void HttpCacheManager::writeRecord(char type, const std::string& data, bool sync)
+{
+    if (!journal)
+        return;
+    fprintf(journal, "%c %zu\n", type, data.length());
+    fwrite(data.c_str(), 1, data.length(), journal);
+    fputc('\n', journal);
+    fflush(journal);
+    if (sync)
+        fsync(fileno(journal));
+}
+
+void HttpCacheManager::load()
+{
+    loaded = true;
+    if (path.empty())
+        return;
+
+    std::ifstream index(getIndexPath().c_str(), std::ios::in | std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(index)), std::istreambuf_iterator<char>());
+    index.close();
+
+    // Replay the journal.
+    std::map<std::string, std::pair<unsigned, std::string>> entries;
+    unsigned sequence = 0;
+    for (size_t pos = 0; pos < data.length(); ++sequence) {
+        char type;
+        size_t length;
+        int count;
+        if (sscanf(data.c_str() + pos, "%c %zu\n%n", &type, &length, &count) != 2)
+            break;
+        pos += count;
+        if (data.length() < pos + length + 1 || data[pos + length] != '\n')
+            break;
+        std::string record(data, pos, length);
+        pos += length + 1;
+        std::string url(record, 0, record.find('\n'));
+        if (type == 'P')
+            entries[url] = std::make_pair(sequence, record);
+        else if (type == 'D')
+            entries.erase(url);
+        else
+            break;
+    }
+
+    std::map<unsigned, std::string> records;
+    for (auto i = entries.begin(); i != entries.end(); ++i)
+        records[i->second.first] = i->second.second;
+    std::set<std::string> names;
+    for (auto i = records.begin(); i != records.end(); ++i) {
+        std::istringstream record(i->second);
+        std::string url;
+        std::string name;
+        long long requestTime;
+        unsigned long long contentLength;
+        std::getline(record, url);
+        std::getline(record, name);
+        if (!(record >> requestTime >> contentLength))
+            continue;
+        record.ignore(1);
+        std::string head((std::istreambuf_iterator<char>(record)), std::istreambuf_iterator<char>());
+
+        // Make sure the content has been saved completely.
+        std::string filePath = path + '/' + name;
+        struct stat status;
+        if (name.find('/') != std::string::npos || stat(filePath.c_str(), &status) != 0 ||
+            static_cast<unsigned long long>(status.st_size) != contentLength)
+            continue;
+
+        HttpResponseMessage response;
+        if (!response.parse(head.c_str(), head.c_str() + head.length()))
+            continue;
+        HttpCache* cache = insert(URL(utfconv(url)));
+        if (!cache)
+            break;
+        cache->response = response;
+        cache->filePath = filePath;
+        cache->requestTime = requestTime;
+        cache->contentLength = contentLength;
+        cache->stored = true;
+        totalSize += contentLength;
+        names.insert(name);
+    }
+
+    // Remove the files left behind by the previous session.
+    if (DIR* dir = opendir(path.c_str())) {
+        while (struct dirent* entry = readdir(dir)) {
+            if (strncmp(entry->d_name, "esrille-", 8) == 0 && names.find(entry->d_name) == names.end())
+                ::remove((path + '/' + entry->d_name).c_str());
         }
+        closedir(dir);
     }
-    HttpCache* cache = new(std::nothrow) HttpCache(url);
-    if (cache)
-        lru.push_front(cache);
+
+    save();
+    evict();
+}
+
+bool HttpCacheManager::save()
+{
+    if (journal) {
+        fclose(journal);
+        journal = 0;
+    }
+    std::string indexPath = getIndexPath();
+    std::string tempPath = indexPath + ".new";
+    journal = fopen(tempPath.c_str(), "wb");
+    if (!journal)
+        return false;
+    for (auto i = lru.rbegin(); i != lru.rend(); ++i) {
+        HttpCache* cache = *i;
+        cache->stored = isStored(cache);
+        if (cache->stored)
+            writeRecord('P', getRecord(cache), false);
+    }
+    bool result = fsync(fileno(journal)) == 0;
+    fclose(journal);
+    journal = 0;
+    if (!result || rename(tempPath.c_str(), indexPath.c_str()) != 0)
+        return false;
+    journal = fopen(indexPath.c_str(), "ab");
+    return journal;
+}
+
+void HttpCacheManager::update(HttpCache* cache)
+{
+    totalSize -= cache->contentLength;
+    cache->contentLength = 0;
+    struct stat status;
+    if (cache->buffer)
+        cache->contentLength = cache->buffer->length();
+    else if (!cache->filePath.empty() && stat(cache->filePath.c_str(), &status) == 0)
+        cache->contentLength = status.st_size;
+    totalSize += cache->contentLength;
+    if (isStored(cache)) {
+        writeRecord('P', getRecord(cache));
+        cache->stored = true;
+    } else if (cache->stored) {
+        writeRecord('D', utfconv(cache->url));
+        cache->stored = false;
+    }
+    lru.splice(lru.begin(), lru, cache->position);
+    evict();
+}
+
+// Evicts the least recently used idle entries until the cache fits in the
+// limits. The most recently used entry is always kept as it is about to be
+// used.
+void HttpCacheManager::evict()
+{
+    if (lru.empty())
+        return;
+    for (auto i = lru.end(); (budget < totalSize || maxEntries < lru.size()) && --i != lru.begin();) {
+        HttpCache* cache = *i;
+        if (cache->isBusy() || !cache->requests.empty())
+            continue;
+        ++i;
+        erase(cache);
+        if (cache->stored)
+            writeRecord('D', utfconv(cache->url));
+        delete cache;
+        ++evictionCount;
+    }
+}
+
+HttpCache* HttpCacheManager::getCache(const URL& url)
+{
+    if (!loaded)
+        load();
+    auto found = index.find(getKey(url));
+    if (found != index.end()) {
+        HttpCache* cache = found->second;
+        lru.splice(lru.begin(), lru, cache->position);
+        return cache;
+    }
+    HttpCache* cache = insert(url);
+    if (cache && maxEntries < lru.size())
+        evict();
     return cache;
 }
 
@@ -149,12 +479,15 @@ HttpCache* HttpCacheManager::send(HttpRequest* request)
 
         int code = message.getMethodCode();
         if (code == HttpRequestMessage::GET || code == HttpRequestMessage::HEAD) {
-            if (cache->response.isCacheable() && cache->response.isFresh(cache->requestTime)) {
+            if (!cache->range && cache->response.isCacheable() && cache->response.isFresh(cache->requestTime)) {
                 if (request->redirect(cache->response))
                     continue;
-                if (code == HttpRequestMessage::HEAD || !cache->filePath.empty())
+                if (code == HttpRequestMessage::HEAD || !cache->filePath.empty() || cache->buffer) {
+                    ++hitCount;
                     return cache;
+                }
             }
+            ++missCount;
             return cache->send(request);
         }
         break;
@@ -170,23 +503,95 @@ HttpCache* HttpCacheManager::send(HttpRequest* request)
 
 void HttpCacheManager::remove(HttpCache* cache)
 {
-    lru.remove(cache);
+    erase(cache);
+    if (cache->stored)
+        writeRecord('D', utfconv(cache->url));
+}
+
+void HttpCacheManager::pinFile(const std::string& path)
+{
+    ++pinned[path].first;
+}
+
+void HttpCacheManager::unpinFile(const std::string& path)
+{
+    auto found = pinned.find(path);
+    if (found == pinned.end())
+        return;
+    if (--found->second.first == 0) {
+        if (found->second.second)
+            ::remove(path.c_str());
+        pinned.erase(found);
+    }
+}
+
+void HttpCacheManager::removeFile(const std::string& path)
+{
+    auto found = pinned.find(path);
+    if (found != pinned.end())
+        found->second.second = true;
+    else
+        ::remove(path.c_str());
 }
 
 void HttpCacheManager::dump() {
+    std::cout << "entries: " << lru.size() << " size: " << totalSize <<
+                 " hit: " << hitCount << " miss: " << missCount << " evicted: " << evictionCount << '\n';
     for (auto i = lru.begin(); i != lru.end(); ++i) {
         HttpCache* cache = *i;
         std::cout << static_cast<std::u16string>(cache->url) << ' ' << cache->response.getStatus() << ' ' << cache->filePath << '\n';
     }
 }
 
+// Saves the content kept in memory to a file so that it can be recorded in
+// the index.
+bool HttpCacheManager::saveContent(HttpCache* cache)
+{
+    if (!cache->buffer || !cache->filePath.empty() || cache->isBusy())
+        return false;
+    if (!cache->response.isCacheable() || cache->response.isNoStore())
+        return false;
+    std::string filePath = path + "/esrille-XXXXXX";
+    std::vector<char> tempPath(filePath.begin(), filePath.end());
+    tempPath.push_back('\0');
+    int fd = mkstemp(&tempPath[0]);
+    if (fd == -1)
+        return false;
+    const std::string& data(*cache->buffer);
+    bool result = write(fd, data.c_str(), data.length()) == static_cast<ssize_t>(data.length());
+    if (close(fd) != 0 || !result) {
+        ::remove(&tempPath[0]);
+        return false;
+    }
+    cache->filePath = &tempPath[0];
+    return true;
+}
+
 HttpCacheManager::~HttpCacheManager()
 {
+    if (loaded && !path.empty()) {
+        for (auto i = lru.begin(); i != lru.end(); ++i)
+            saveContent(*i);
+        // Keep the files of the entries saved in the index.
+        save();
+        for (auto i = lru.begin(); i != lru.end(); ++i) {
+            if ((*i)->stored)
+                (*i)->filePath.clear();
+        }
+    }
+    if (journal) {
+        fclose(journal);
+        journal = 0;
+    }
     while (!lru.empty()) {
         HttpCache* cache = lru.front();
         remove(cache);
         delete cache;
     }
+    for (auto i = pinned.begin(); i != pinned.end(); ++i) {
+        if (i->second.second)
+            ::remove(i->first.c_str());
+    }
 }
 
 }}}}  // org::w3c::dom::bootstrap
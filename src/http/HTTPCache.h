@@ -17,8 +17,11 @@
 #ifndef ES_HTTP_CACHE_H
 #define ES_HTTP_CACHE_H
 
+#include <cstdio>
 #include <fstream>
 #include <list>
+#include <unordered_map>
+#include <utility>
 
 #include "http/HTTPRequest.h"
 
@@ -33,18 +36,24 @@ class HttpCache
     unsigned long long contentLength;
 
     std::string filePath;
+    std::shared_ptr<std::string> buffer;    // the content kept in memory
+    HttpContentSpan span;
 
     long long requestTime;
 
     std::string etag;
-    bool range;
+    bool range;     // true if only the first contentLength octets have been received
     bool mustRevalidate;
     int hitCount;
+    bool stored;    // true if recorded in the index of the persistent cache
 
     std::list<HttpRequest*> requests;
     HttpRequest* current;
 
+    std::list<HttpCache*>::iterator position;  // in HttpCacheManager::lru
+
     HttpCache* send(HttpRequest* request);
+    bool keepPartial(HttpRequest* request);
 
 public:
 
@@ -55,6 +64,13 @@ public:
     const std::string& getFilePath() const {
         return filePath;
     }
+    unsigned long long getContentLength() const {
+        return contentLength;
+    }
+    const std::shared_ptr<std::string>& getContentBuffer() const {
+        return buffer;
+    }
+    const HttpContentSpan& getContentSpan();
 
     void notify(HttpRequest* request, bool error);
 
@@ -73,26 +89,103 @@ public:
         range(false),
         mustRevalidate(false),
         hitCount(0),
+        stored(false),
         current(0)
     {
     }
 
-    ~HttpCache()
-    {
-        if (!filePath.empty())
-            remove(filePath.c_str());
-    }
+    ~HttpCache();
 };
 
 class HttpCacheManager
 {
-    std::list<HttpCache*> lru;
+    static const unsigned long long DefaultBudget = 64 * 1024 * 1024;
+    static const size_t DefaultMaxEntries = 4096;
+
+    std::list<HttpCache*> lru;                               // the most recently used first
+    std::unordered_map<std::u16string, HttpCache*> index;   // by getKey()
+    // The content files referred to by the completed requests, with the
+    // number of the requests and whether the file has been removed from
+    // the cache. The file is unlinked once it is no longer pinned.
+    std::unordered_map<std::string, std::pair<unsigned, bool>> pinned;
+    size_t maxEntries;
+    unsigned long long budget;
+    unsigned long long totalSize;
+
+    // statistics
+    unsigned long long hitCount;
+    unsigned long long missCount;
+    unsigned long long evictionCount;
+
+    // for the persistent cache
+    std::string path;       // the cache directory; empty if not persistent
+    std::FILE* journal;     // the index file opened for appending records
+    bool loaded;
+
+    static std::u16string getKey(const URL& url);
+    HttpCache* insert(const URL& url);
+    void erase(HttpCache* cache);
+
+    std::string getIndexPath() const {
+        return path + "/index";
+    }
+    bool isStored(HttpCache* cache) const;
+    std::string getRecord(HttpCache* cache) const;
+    void writeRecord(char type, const std::string& data, bool sync = true);
+    void load();
+    bool save();
+    bool saveContent(HttpCache* cache);
+    void evict();
+
 public:
+    HttpCacheManager() :
+        maxEntries(DefaultMaxEntries),
+        budget(DefaultBudget),
+        totalSize(0),
+        hitCount(0),
+        missCount(0),
+        evictionCount(0),
+        journal(0),
+        loaded(false)
+    {
+    }
     ~HttpCacheManager();
 
+    // Keeps the cached responses in the specified directory across
+    // sessions, up to budget octets in total. Call this before sending any
+    // request as the files left in the directory by the previous session
+    // are removed.
+    void setPersistent(const std::string& directory, unsigned long long budget = DefaultBudget);
+    // Limits the number of the entries and the total size of the cached
+    // responses. The idle entries are evicted in the LRU order.
+    void setLimits(size_t maxEntries, unsigned long long budget);
+
+    size_t getEntryCount() const {
+        return lru.size();
+    }
+    unsigned long long getTotalSize() const {
+        return totalSize;
+    }
+    unsigned long long getHitCount() const {
+        return hitCount;
+    }
+    unsigned long long getMissCount() const {
+        return missCount;
+    }
+    unsigned long long getEvictionCount() const {
+        return evictionCount;
+    }
+
     HttpCache* getCache(const URL& url);
     HttpCache* send(HttpRequest* request);
     void remove(HttpCache* cache);
+    void pinFile(const std::string& path);
+    void unpinFile(const std::string& path);
+    // Removes the content file of an entry, or defers it while requests
+    // refer to the file.
+    void removeFile(const std::string& path);
+    // Records the current state of the cache in the index.
+    void update(HttpCache* cache);
 
     void dump();
 
@@ -17,6 +17,7 @@
 #include "HTTPConnection.h"
 
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <boost/bind.hpp>
 
@@ -29,13 +30,30 @@ namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
 using namespace http;
 
+namespace {
+
+// Inserts the request after the other requests of the same or higher priority.
+void insert(std::list<HttpRequest*>& list, HttpRequest* request)
+{
+    auto i = list.begin();
+    while (i != list.end() && (*i)->getPriority() <= request->getPriority())
+        ++i;
+    list.insert(i, request);
+}
+
+}  // namespace
+
+const int HttpConnectionManager::HostTimeToLive;
+const int HttpConnectionManager::NegativeHostTimeToLive;
+
+const int HttpConnection::KeepAliveTimeout;
+
 const char* HttpConnection::States[] = {
     "Closed",
     "Resolving",
     "Resolved",
     "Connected",
     "Handshaking",
-    "ReadStatusLine",
     "ReadHead",
     "ReadContent",
     "ReadChunk",
@@ -46,20 +64,50 @@ const char* HttpConnection::States[] = {
 HttpConnection::HttpConnection(const std::string& protocol, const std::string& hostname, const std::string& port) :
     state(Closed),
     retryCount(0),
+    persistent(false),
+    pipelined(false),
+    scanned(0),
     protocol(protocol),
     hostname(hostname),
     port(port),
     socket(HttpConnectionManager::getIOService()),
-    context(boost::asio::ssl::context::sslv23),
-    secureSocket(socket, context),
+    idleTimer(HttpConnectionManager::getIOService()),
     current(0)
 {
-    if (protocol == "https:") {
-        context.set_options(boost::asio::ssl::context::no_sslv2);
-        context.set_default_verify_paths();
-        secureSocket.set_verify_mode(boost::asio::ssl::verify_peer);
-        secureSocket.set_verify_callback(boost::asio::ssl::rfc2818_verification(hostname));
-    }
+}
+
+void HttpConnection::connect()
+{
+    state = Resolving;
+    HttpConnectionManager::getInstance().resolve(hostname, port,
+                                                 boost::bind(&HttpConnection::handleResolve, this,
+                                                             boost::asio::placeholders::error,
+                                                             boost::asio::placeholders::iterator));
+}
+
+// Creates a new SSL stream over the connected socket since an SSL object
+// cannot be reused for another handshake.
+bool HttpConnection::createSecureSocket()
+{
+    HttpConnectionManager& manager(HttpConnectionManager::getInstance());
+    // The previous stream is released once its pending handlers are called.
+    secureSocket.reset(new(std::nothrow) SecureSocket(socket, manager.getSSLContext()));
+    if (!secureSocket)
+        return false;
+    secureSocket->set_verify_mode(boost::asio::ssl::verify_peer);
+    secureSocket->set_verify_callback(boost::asio::ssl::rfc2818_verification(hostname));
+    SSL* ssl = secureSocket->native_handle();
+    SSL_set_tlsext_host_name(ssl, hostname.c_str());
+    SSL_set_app_data(ssl, this);
+    manager.resumeSession(ssl, hostname, port);
+    return true;
+}
+
+// Keeps the connection alive for a while.
+void HttpConnection::keepAlive()
+{
+    idleTimer.expires_from_now(boost::posix_time::seconds(KeepAliveTimeout));
+    idleTimer.async_wait(boost::bind(&HttpConnection::handleIdleTimeout, this, boost::asio::placeholders::error));
 }
 
 void HttpConnection::sendRequest()
@@ -70,25 +118,57 @@ void HttpConnection::sendRequest()
     std::ostream stream(&request);
     stream << current->getRequestMessage().toString();
     stream << "\r\n";
+    while (!requests.empty() && pipeline.size() < MaxPipelineDepth && canPipeline(requests.front())) {
+        HttpRequest* next = requests.front();
+        requests.pop_front();
+        if (3 <= getLogLevel())
+            std::cerr << __func__ << " (pipelined) " << next->getRequestMessage().toString() << '\n';
+        stream << next->getRequestMessage().toString();
+        stream << "\r\n";
+        pipeline.push_back(next);
+    }
     asyncWrite(request, boost::bind(&HttpConnection::handleWriteRequest, this, boost::asio::placeholders::error));
 }
 
+bool HttpConnection::canPipeline(HttpRequest* request)
+{
+    if (!persistent || !HttpConnectionManager::getInstance().isPipelining())
+        return false;
+    // Pipeline only idempotent requests.
+    int code = current->getRequestMessage().getMethodCode();
+    if (code != HttpRequestMessage::GET && code != HttpRequestMessage::HEAD)
+        return false;
+    code = request->getRequestMessage().getMethodCode();
+    return code == HttpRequestMessage::GET || code == HttpRequestMessage::HEAD;
+}
+
 void HttpConnection::done(HttpConnectionManager* manager, bool error)
 {
-    line.clear();
+    scanned = 0;
+    pipelined = false;
     if (current) {
         HttpRequest* request = current;
         current = 0;
-        manager->complete(request, error);
+        if (isStandIn(request))
+            dropStandIn(request);
+        else
+            manager->complete(request, error || !finishContent(request));
     }
+    decoder.close();
     if (!error) {
         retryCount = 0;
-        if (!requests.empty()) {
+        if (!pipeline.empty()) {
+            // The response is to be read by readNext().
+            current = pipeline.front();
+            pipeline.pop_front();
+            pipelined = true;
+        } else if (!requests.empty()) {
             // Note at this point, the socket might have been closed.
             HttpRequest* request = requests.front();
             requests.pop_front();
             send(request);
-        }
+        } else if (socket.is_open())
+            keepAlive();
     } else {
         while (!requests.empty()) {
             current = requests.front();
@@ -102,8 +182,20 @@ void HttpConnection::done(HttpConnectionManager* manager, bool error)
 void HttpConnection::close()
 {
     state = Closed;
-    line.clear();
+    scanned = 0;
     retryCount = 0;
+    persistent = false;
+    pipelined = false;
+    // Send the pipelined requests again over a new connection except for
+    // the aborted ones.
+    for (auto i = pipeline.begin(); i != pipeline.end();) {
+        if (isStandIn(*i)) {
+            dropStandIn(*i);
+            i = pipeline.erase(i);
+        } else
+            ++i;
+    }
+    requests.splice(requests.begin(), pipeline);
     socket.close();
     request.consume(request.size());
     response.consume(response.size());
@@ -116,6 +208,11 @@ void HttpConnection::retry()
 
     int count = retryCount;
     close();
+    if (isStandIn(current)) {
+        // No need to read the response to the aborted request again.
+        HttpConnectionManager::getInstance().done(this, false);
+        return;
+    }
     retryCount = count + 1;
     if (retryCount < MaxRetryCount) {
         HttpRequest* request = current;
@@ -125,6 +222,40 @@ void HttpConnection::retry()
         HttpConnectionManager::getInstance().done(this, true);
 }
 
+// Requests the rest of the content that has been interrupted by the server
+// instead of starting over. Only the identity content-coding is resumed as
+// the offset must be the one in the decoded content.
+// cf. http://tools.ietf.org/html/draft-ietf-httpbis-p5-range-22#section-3.1
+bool HttpConnection::resume()
+{
+    if (isStandIn(current))
+        return false;
+    HttpRequestMessage& requestMessage = current->getRequestMessage();
+    HttpResponseMessage& responseMessage = current->getResponseMessage();
+    if (MaxRetryCount <= retryCount + 1 || octetCount == 0 || contentLength <= octetCount ||
+        decoder.getCoding() != HttpContentDecoder::Identity ||
+        requestMessage.getMethodCode() != HttpRequestMessage::GET ||
+        responseMessage.getStatus() != 200 || !responseMessage.hasContentLengthHeader())
+        return false;
+    std::string validator = responseMessage.getRangeValidator();
+    if (validator.empty())
+        return false;
+
+    if (3 <= getLogLevel())
+        std::cerr << __func__ << ' ' << requestMessage.getURL() << ": " << octetCount << '\n';
+
+    current->resumeOffset = octetCount;
+    current->resumeResponse = responseMessage;
+    requestMessage.setHeader("Range", "bytes=" + std::to_string(octetCount) + "-");
+    requestMessage.setHeader("If-Range", validator);
+    requestMessage.setHeader("Accept-Encoding", "identity");
+    requestMessage.removeHeader("If-None-Match");
+    requestMessage.removeHeader("If-Modified-Since");
+    responseMessage.clear();
+    retry();
+    return true;
+}
+
 void HttpConnection::handleResolve(const boost::system::error_code& err, boost::asio::ip::tcp::resolver::iterator endpointIterator)
 {
     if (3 <= getLogLevel())
@@ -136,6 +267,7 @@ void HttpConnection::handleResolve(const boost::system::error_code& err, boost::
         socket.async_connect(endpoint, boost::bind(&HttpConnection::handleConnect, this, boost::asio::placeholders::error, ++endpointIterator));
         return;
     }
+    close();
     HttpConnectionManager::getInstance().done(this, true);
 }
 
@@ -147,7 +279,12 @@ void HttpConnection::handleConnect(const boost::system::error_code& err, boost::
     if (!err) {
         if (protocol == "https:" && state == Resolved) {
             state = Handshaking;
-            secureSocket.async_handshake(boost::asio::ssl::stream_base::client, boost::bind(&HttpConnection::handleHandshake, this, boost::asio::placeholders::error));
+            if (!createSecureSocket()) {
+                close();
+                HttpConnectionManager::getInstance().done(this, true);
+                return;
+            }
+            asyncHandshake(boost::bind(&HttpConnection::handleHandshake, this, boost::asio::placeholders::error));
         } else {
             state = Connected;
             boost::asio::ip::tcp::no_delay option(true);
@@ -155,16 +292,21 @@ void HttpConnection::handleConnect(const boost::system::error_code& err, boost::
             if (current) {
                 sendRequest();
                 asyncRead(response, boost::asio::transfer_at_least(1), boost::bind(&HttpConnection::handleRead, this, boost::asio::placeholders::error));
-            }
+            } else
+                keepAlive();    // preconnected
         }
         return;
     }
+    if (err == boost::asio::error::operation_aborted && state == Closed)
+        return;     // closed while connecting
     if (endpointIterator != boost::asio::ip::tcp::resolver::iterator()) {
         close();
+        state = Resolved;
         boost::asio::ip::tcp::endpoint endpoint = *endpointIterator;
         socket.async_connect(endpoint, boost::bind(&HttpConnection::handleConnect, this, boost::asio::placeholders::error, ++endpointIterator));
         return;
     }
+    close();
     HttpConnectionManager::getInstance().done(this, true);
 }
 
@@ -180,7 +322,8 @@ void HttpConnection::handleHandshake(const boost::system::error_code& err)
         if (current) {
             sendRequest();
             asyncRead(response, boost::asio::transfer_at_least(1), boost::bind(&HttpConnection::handleRead, this, boost::asio::placeholders::error));
-        }
+        } else
+            keepAlive();    // preconnected
         return;
     }
     close();
@@ -195,9 +338,6 @@ void HttpConnection::handleRead(const boost::system::error_code& err)
     switch (state) {
     case Closed:
         break;
-    case ReadStatusLine:
-        readStatusLine(err);
-        break;
     case ReadHead:
         readHead(err);
         break;
@@ -220,12 +360,35 @@ void HttpConnection::handleRead(const boost::system::error_code& err)
     }
 }
 
+// Reads the next response, or waits for the server closing the connection.
+void HttpConnection::readNext()
+{
+    if (current && pipelined) {
+        state = ReadHead;
+        if (0 < response.size()) {
+            readHead(boost::system::error_code());
+            return;
+        }
+    } else
+        state = CloseWait;
+    asyncRead(response, boost::asio::transfer_at_least(1), boost::bind(&HttpConnection::handleRead, this, boost::asio::placeholders::error));
+}
+
+void HttpConnection::handleIdleTimeout(const boost::system::error_code& err)
+{
+    if (err == boost::asio::error::operation_aborted)
+        return;
+    HttpConnectionManager::getInstance().expire(this);
+}
+
 void HttpConnection::handleWriteRequest(const boost::system::error_code& err)
 {
     if (3 <= getLogLevel())
         std::cerr << __func__ << ' ' << err <<  '\n';
 
     if (!err && current) {
+        if (pipelined)
+            return;  // the responses are being read already
         if (state != Connected && state != CloseWait) {
             retry();
             return;
@@ -233,119 +396,113 @@ void HttpConnection::handleWriteRequest(const boost::system::error_code& err)
         if (current->getRequestMessage().getVersion() < 10)
             state = ReadContent;
         else
-            state = ReadStatusLine;
+            state = ReadHead;
         return;
     }
     close();
     HttpConnectionManager::getInstance().done(this, true);
 }
 
-void HttpConnection::readStatusLine(const boost::system::error_code& err)
+void HttpConnection::readHead(const boost::system::error_code& err)
 {
     if (err && err != boost::asio::error::eof) {
         close();
         HttpConnectionManager::getInstance().done(this, true);
         return;
     }
+    // Ignore empty lines preceding the status line.
+    if (!scanned) {
+        const char* start = boost::asio::buffer_cast<const char*>(response.data());
+        const char* end = start + response.size();
+        const char* p = start;
+        while (p < end && (*p == '\r' || *p == '\n'))
+            ++p;
+        response.consume(p - start);
+    }
+
+    // Scan the head in the stream buffer where it has been received, and
+    // keep it there until it is complete.
     const char* start = boost::asio::buffer_cast<const char*>(response.data());
     const char* end = start + response.size();
-    const char* eol = std::find(start, end, '\n');
-    if (eol == end) {
+    const char* next = start + scanned;
+    const char* eoh = findEndOfHead(next, end, next);
+    if (!eoh) {
+        scanned = next - start;
         if (err == boost::asio::error::eof) {
-            retry();
+            // Retry if not even the status line has been received.
+            if (scanned) {
+                close();
+                HttpConnectionManager::getInstance().done(this, true);
+            } else
+                retry();
+            return;
+        }
+        if (MaxHeadSize <= response.size()) {
+            close();
+            HttpConnectionManager::getInstance().done(this, true);
             return;
         }
-        line += std::string(start, response.size());
-        response.consume(response.size());
         asyncRead(response, boost::asio::transfer_at_least(1), boost::bind(&HttpConnection::handleRead, this, boost::asio::placeholders::error));
         return;
     }
-    ++eol;
-    if (!line.empty()) {
-        line += std::string(start, eol - start);
-        response.consume(eol - start);
-        start = line.c_str();
-        eol = start + line.length();
-    }
 
     if (3 <= getLogLevel())
-        std::cerr << __func__ << ": " <<  std::string(start, eol - start) << '\n';
+        std::cerr << __func__ << ": " << std::string(start, eoh - start);
 
-    const char* statusLine = current->getResponseMessage().parseStatusLine(start, eol);
-    if (!statusLine) {
+    if (!current->getResponseMessage().parse(start, eoh)) {
         close();
         HttpConnectionManager::getInstance().done(this, true);
         return;
     }
-    if (line.empty())
-        response.consume(eol - start);
-    line.clear();
-    state = ReadHead;
-    readHead(err);
+    response.consume(eoh - start);
+    scanned = 0;
+    processHead(err);
 }
 
-void HttpConnection::readHead(const boost::system::error_code& err)
+void HttpConnection::processHead(const boost::system::error_code& err)
 {
-    if (err && err != boost::asio::error::eof) {
+    HttpResponseMessage& responseMessage = current->getResponseMessage();
+    std::string connection = responseMessage.getResponseHeader(HttpHeader::Connection);
+    std::transform(connection.begin(), connection.end(), connection.begin(), ::tolower);
+    persistent = 11 <= responseMessage.getVersion() && connection.find("close") == std::string::npos;
+
+    // Transfer-Encoding of a 206 response is not merged.
+    bool chunked = responseMessage.isChunked();
+    unsigned long long offset = 0;
+    if (current->resumeOffset && !mergeContent(offset)) {
         close();
         HttpConnectionManager::getInstance().done(this, true);
         return;
     }
-    HttpResponseMessage& responseMessage = current->getResponseMessage();
-    for (;;) {
-        const char* start = boost::asio::buffer_cast<const char*>(response.data());
-        const char* end = start + response.size();
-        const char* eol = std::find(start, end, '\n');
-        if (eol == end) {
-            if (err == boost::asio::error::eof) {
-                close();
-                HttpConnectionManager::getInstance().done(this, true);
-                return;
-            }
-            line += std::string(start, response.size());
-            response.consume(response.size());
-            asyncRead(response, boost::asio::transfer_at_least(1), boost::bind(&HttpConnection::handleRead, this, boost::asio::placeholders::error));
-            return;
-        }
-        ++eol;
-        if (!line.empty()) {
-            line += std::string(start, eol - start);
-            response.consume(eol - start);
-            start = line.c_str();
-            eol = start + line.length();
-        }
-
-        if (3 <= getLogLevel())
-            std::cerr << __func__ << ": " <<  std::string(start, eol - start);
-
-        const char* header = parseCRLF(start, eol);
-        if (*header == '\n') {
-            if (line.empty())
-                response.consume(eol - start);
-            else
-                line.clear();
-            break;
-        }
-        header = responseMessage.parseHeader(start, eol);
-        if (!header) {
-            close();
-            HttpConnectionManager::getInstance().done(this, true);
-            return;
-        }
-        if (line.empty())
-            response.consume(eol - start);
-        line.clear();
-    }
 
     // TODO: handle every status code
     switch (responseMessage.getStatus()) {
     case 304:   // Not Modified
-        return;
+        break;
     default:
-        octetCount = 0;
-        if (responseMessage.isChunked()) {
+        octetCount = offset;
+        if (!decoder.open(responseMessage.getResponseHeader(HttpHeader::ContentEncoding))) {
+            // The content of an unsupported coding cannot be used.
+            close();
+            HttpConnectionManager::getInstance().done(this, true);
+            return;
+        }
+        if (!responseMessage.shouldRedirect())
+            HttpConnectionManager::getInstance().load(current);
+        if (offset) {
+            bool restored = decoder.getCoding() == HttpContentDecoder::Identity &&
+                            (current->resumePath.empty() || restoreContent(current->resumePath, offset));
+            current->resumePath.clear();
+            if (!restored) {
+                close();
+                HttpConnectionManager::getInstance().done(this, true);
+                return;
+            }
+        }
+        if (chunked) {
+            chunkData = false;
             chunkCRLF = 0;
-            contentLength = 0;
+            contentLength = offset;
             state = ReadChunk;
             readChunk(err);
             return;
@@ -360,31 +517,29 @@ void HttpConnection::readHead(const boost::system::error_code& err)
     }
 
     HttpConnectionManager::getInstance().done(this, false);
-    if (!err) {
-        state = CloseWait;
-        asyncRead(response, boost::asio::transfer_at_least(1), boost::bind(&HttpConnection::handleRead, this, boost::asio::placeholders::error));
-    }
+    if (!err)
+        readNext();
 }
 
 void HttpConnection::readContent(const boost::system::error_code& err)
 {
     if (!err || err == boost::asio::error::eof) {
-        std::fstream& content = current->getContent();
-        if (!content.is_open()) {
+        if (!current->getContent()) {
             HttpConnectionManager::getInstance().done(this, true);
             return;
         }
         bool completed = false;
         if (0 < response.size()) {
-            if (!contentLength) {
-                octetCount += response.size();
-                content << &response;
-            } else {
-                unsigned long long length = std::min(static_cast<unsigned long long>(response.size()), contentLength - octetCount);
-                content.write(boost::asio::buffer_cast<const char*>(response.data()), length);
-                response.consume(length);
-                octetCount += length;
+            unsigned long long length = response.size();
+            if (contentLength)
+                length = std::min(length, contentLength - octetCount);
+            if (!writeContent(boost::asio::buffer_cast<const char*>(response.data()), length)) {
+                close();
+                HttpConnectionManager::getInstance().done(this, true);
+                return;
             }
+            response.consume(length);
+            octetCount += length;
             if (contentLength <= octetCount)
                 completed = true;
         }
@@ -392,8 +547,9 @@ void HttpConnection::readContent(const boost::system::error_code& err)
             asyncRead(response, boost::asio::transfer_at_least(1), boost::bind(&HttpConnection::handleRead, this, boost::asio::placeholders::error));
             return;
         }
-        content.flush();
     }
+    if (err && octetCount < contentLength && resume())
+        return;
     if (err == boost::asio::error::eof) {
         close();
         if (contentLength < octetCount) {
@@ -404,71 +560,67 @@ void HttpConnection::readContent(const boost::system::error_code& err)
         return;
     }
     HttpConnectionManager::getInstance().done(this, err);
-    state = CloseWait;
-    asyncRead(response, boost::asio::transfer_at_least(1), boost::bind(&HttpConnection::handleRead, this, boost::asio::placeholders::error));
+    readNext();
 }
 
 void HttpConnection::readChunk(const boost::system::error_code& err)
 {
     if (!err || err == boost::asio::error::eof) {
-        std::fstream& content = current->getContent();
-        if (!content.is_open()) {
+        if (!current->getContent()) {
             HttpConnectionManager::getInstance().done(this, true);
             return;
         }
-        bool completed = false;
         while (0 < response.size()) {
-            if (line.empty() || line[line.length() - 1] != '\n') {
-                const char* chunk = boost::asio::buffer_cast<const char*>(response.data());
-                const char* chunkEnd = chunk + response.size();
-                auto p = std::find(chunk, chunkEnd, '\n');
-                if (p == chunkEnd) {
-                    line += std::string(chunk, response.size());
-                    response.consume(response.size());
-                    // TODO: check error and length
-                } else {
-                    line += std::string(chunk, p - chunk + 1);
-                    response.consume(p - chunk + 1);
-                    parseHexDigits(line.c_str(), line.c_str() + line.length(), chunkLength);
-                    contentLength += chunkLength;
-                    if (chunkLength == 0) {
-                        if (line[0] != '0') {
-                            HttpConnectionManager::getInstance().done(this, true);
-                            close();
-                            return;
-                        }
-                        completed = true;
-                        content.flush();
-                        chunkCRLF = 1;
-                    }
-                }
-            }
-            if (!completed) {
-                if (0 < response.size() && octetCount < contentLength) {
-                    unsigned long long length = std::min(static_cast<unsigned long long>(response.size()), contentLength - octetCount);
-                    content.write(boost::asio::buffer_cast<const char*>(response.data()), length);
-                    response.consume(length);
-                    octetCount += length;
-                }
-                while (0 < response.size() && contentLength <= octetCount) {
-                    int c = response.sbumpc();
-                    if (c == '\n') {
-                        chunkCRLF = 0;
-                        line.clear();
-                        break;
-                    } else if (c == '\r' && chunkCRLF == 0)
-                        ++chunkCRLF;
-                    else {
+            const char* start = boost::asio::buffer_cast<const char*>(response.data());
+            const char* end = start + response.size();
+            if (!chunkData) {
+                // chunk-size [ chunk-extension ] CRLF
+                const char* eol = findLF(start + scanned, end);
+                if (eol == end) {
+                    scanned = response.size();
+                    if (MaxHeadSize <= scanned) {
                         HttpConnectionManager::getInstance().done(this, true);
                         close();
                         return;
                     }
+                    break;
                 }
+                if (!isxdigit(*start)) {
+                    HttpConnectionManager::getInstance().done(this, true);
+                    close();
+                    return;
+                }
+                parseHexDigits(start, eol, chunkLength);
+                response.consume(eol + 1 - start);
+                scanned = 0;
+                if (chunkLength == 0) {
+                    state = ReadTrailer;
+                    readTrailer(err);
+                    return;
+                }
+                contentLength += chunkLength;
+                chunkData = true;
+            } else if (octetCount < contentLength) {
+                unsigned long long length = std::min(static_cast<unsigned long long>(end - start), contentLength - octetCount);
+                if (!writeContent(start, length)) {
+                    HttpConnectionManager::getInstance().done(this, true);
+                    close();
+                    return;
+                }
+                response.consume(length);
+                octetCount += length;
             } else {
-                // TODO: process trailer
-                state = ReadTrailer;
-                readTrailer(err);
-                return;
+                int c = response.sbumpc();
+                if (c == '\n') {
+                    chunkCRLF = 0;
+                    chunkData = false;
+                } else if (c == '\r' && chunkCRLF == 0)
+                    ++chunkCRLF;
+                else {
+                    HttpConnectionManager::getInstance().done(this, true);
+                    close();
+                    return;
+                }
             }
         }
         if (!err) {
@@ -481,25 +633,108 @@ void HttpConnection::readChunk(const boost::system::error_code& err)
     close();
 }
 
+// Writes the content through the decoder so that the decoded octets become
+// readable via the content descriptor.
+bool HttpConnection::writeContent(const char* data, size_t length)
+{
+    long long count = decoder.write(current->getContent(), data, length);
+    if (count < 0 || !current->flushContent())
+        return false;
+    current->octetCount += count;
+    if (0 < count && current->progressHandler && current->readyState == HttpRequest::LOADING)
+        HttpConnectionManager::getInstance().progress(current);
+    return true;
+}
+
+// Rewrites the response head for the decoded content. Returns false if the
+// encoded content has been truncated.
+bool HttpConnection::finishContent(HttpRequest* request)
+{
+    if (decoder.getCoding() == HttpContentDecoder::Identity)
+        return true;
+    if (decoder.isTruncated())
+        return false;
+    request->getResponseMessage().setDecodedContentLength(request->getContentOctetCount());
+    return true;
+}
+
+// Merges the response to the resumed request into the response that has
+// been interrupted at resumeOffset, and sets offset to the octets to be
+// continued from. Returns false if the content can be neither resumed nor
+// restarted.
+// cf. http://tools.ietf.org/html/draft-ietf-httpbis-p5-range-22#section-4.1
+bool HttpConnection::mergeContent(unsigned long long& offset)
+{
+    HttpResponseMessage& responseMessage = current->getResponseMessage();
+    const HttpResponseMessage& original = current->resumeResponse;
+    unsigned long long resumeOffset = current->resumeOffset;
+    current->resumeOffset = 0;
+
+    if (responseMessage.getStatus() == 200) {
+        // The representation has been changed; start over unless the
+        // partial content has been read already.
+        current->resumePath.clear();
+        if (!current->octetCount)
+            return true;
+        if (current->progressCount || current->getPriority() == HttpRequest::DOCUMENT_PRIORITY)
+            return false;
+        current->clearContent();
+        current->removeFile();
+        current->octetCount = 0;
+        return true;
+    }
+
+    unsigned long long first;
+    unsigned long long last;
+    unsigned long long length;
+    if (responseMessage.getStatus() != 206 || !responseMessage.getContentRange(first, last, length) ||
+        first != resumeOffset || last + 1 != original.getContentLength() || (length && length != last + 1))
+        return false;
+    HttpResponseMessage partial(responseMessage);
+    responseMessage = original;
+    responseMessage.update(partial);
+    offset = first;
+    return true;
+}
+
+// Copies the partial content kept in the cache in front of the rest.
+bool HttpConnection::restoreContent(const std::string& path, unsigned long long length)
+{
+    std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+    char buffer[16384];
+    while (0 < length) {
+        file.read(buffer, std::min(static_cast<unsigned long long>(sizeof buffer), length));
+        std::streamsize count = file.gcount();
+        if (count <= 0 || !writeContent(buffer, count))
+            return false;
+        length -= count;
+    }
+    return true;
+}
+
 void HttpConnection::readTrailer(const boost::system::error_code& err)
 {
     if (!err || err == boost::asio::error::eof) {
-        while (0 < response.size()) {
-            int c = response.sbumpc();
-            if (c == '\n') {
-                if (++chunkCRLF == 2) {
-                    // TODO: set Content-length:
-                    HttpConnectionManager::getInstance().done(this, false);
-                    if (err)
-                        close();
-                    else {
-                        state = CloseWait;
-                        asyncRead(response, boost::asio::transfer_at_least(1), boost::bind(&HttpConnection::handleRead, this, boost::asio::placeholders::error));
-                    }
-                    return;
-                }
-            } else if (c != '\r')
-                chunkCRLF = 0;
+        // The trailer fields are skipped up to the empty line.
+        const char* start = boost::asio::buffer_cast<const char*>(response.data());
+        const char* end = start + response.size();
+        const char* next = start + scanned;
+        if (const char* eot = findEndOfHead(next, end, next)) {
+            response.consume(eot - start);
+            scanned = 0;
+            // TODO: set Content-length:
+            HttpConnectionManager::getInstance().done(this, false);
+            if (err)
+                close();
+            else
+                readNext();
+            return;
+        }
+        scanned = next - start;
+        if (MaxHeadSize <= response.size()) {
+            HttpConnectionManager::getInstance().done(this, true);
+            close();
+            return;
         }
         if (!err) {
             asyncRead(response, boost::asio::transfer_at_least(1), boost::bind(&HttpConnection::handleRead, this, boost::asio::placeholders::error));
@@ -515,26 +750,78 @@ void HttpConnection::send(HttpRequest* request)
 {
     if (current) {
         assert(current != request);
-        requests.push_back(request);
+        insert(requests, request);
         return;
     }
     current = request;
+    idleTimer.cancel();
 
+    switch (state) {
+    case Resolving:
+    case Resolved:
+    case Handshaking:
+        return;     // being preconnected; current is sent once connected
+    default:
+        break;
+    }
     if (socket.is_open()) {
         sendRequest();
         return;
     }
+    connect();
+}
 
-    state = Resolving;
-    boost::asio::ip::tcp::resolver::query query(hostname, port);
-    HttpConnectionManager::getInstance().resolve(query,
-                                                 boost::bind(&HttpConnection::handleResolve, this,
-                                                             boost::asio::placeholders::error,
-                                                             boost::asio::placeholders::iterator));
+// Discards the part of the response to the request that has been read
+// so that the request can be sent again. Returns false if the content has
+// been passed to the progress handler already.
+bool HttpConnection::discard(HttpRequest* request)
+{
+    if (request->progressCount)
+        return false;
+    request->clearContent();
+    request->removeFile();
+    request->octetCount = 0;
+    request->getResponseMessage().clear();
+    request->readyState = HttpRequest::OPENED;
+    return true;
+}
+
+// Frees the stand-in that has read the response to an aborted request.
+void HttpConnection::dropStandIn(HttpRequest* request)
+{
+    standIns.remove(request);
+    request->readyState = HttpRequest::UNSENT;  // not to be aborted again
+    delete request;
 }
 
 void HttpConnection::abort(HttpRequest* request)
 {
+    auto found = std::find(pipeline.begin(), pipeline.end(), request);
+    if (found != pipeline.end()) {
+        // The request has been sent already. Let a stand-in read and drop
+        // the response so that current and the rest of the pipeline are
+        // not disturbed.
+        HttpRequest* standIn = new(std::nothrow) HttpRequest;
+        if (standIn) {
+            standIn->getRequestMessage() = request->getRequestMessage();
+            standIns.push_back(standIn);
+            *found = standIn;
+            request->notify(true);
+            return;
+        }
+        // Start over the requests that follow current over a new connection.
+        pipeline.erase(found);
+        request->notify(true);
+        HttpRequest* next = current;
+        close();
+        current = 0;
+        if (!discard(next)) {
+            HttpConnectionManager::getInstance().complete(next, true);
+            return;
+        }
+        send(next);
+        return;
+    }
     if (current != request) {
         requests.remove(request);
         request->notify(true);
@@ -546,19 +833,76 @@ void HttpConnection::abort(HttpRequest* request)
 
 void HttpConnection::dump()
 {
-    std::cout << "HttpConnection: " << protocol << ' ' << hostname << ' ' << States[state] << ' ' << requests.size() << '\n';
+    std::cout << "HttpConnection: " << protocol << ' ' << hostname << ' ' << States[state] << ' ' << pipeline.size() << ' ' << requests.size() << '\n';
+}
+
+HttpConnection* HttpConnectionManager::getConnection(const std::string& protocol, const std::string& hostname, const std::string& port, unsigned short priority)
+{
+    HttpConnection* leastLoaded = 0;
+    HttpConnection* closed = 0;
+    unsigned count = 0;
+    unsigned active = 0;
+    for (auto i = connections.begin(); i != connections.end(); ++i) {
+        HttpConnection* conn = *i;
+        if (conn->isActive())
+            ++active;
+        if (conn->protocol != protocol || conn->hostname != hostname || conn->port != port)
+            continue;
+        ++count;
+        if (conn->isIdle()) {
+            if (conn->socket.is_open())
+                return conn;    // reuse the persistent connection
+            closed = conn;
+        } else if (!leastLoaded || conn->getLoad(priority) < leastLoaded->getLoad(priority))
+            leastLoaded = conn;
+    }
+    if ((closed || count < maxConnectionsPerHost) && (active < maxConnections || closeIdleConnection())) {
+        if (closed)
+            return closed;
+        HttpConnection* c = new(std::nothrow) HttpConnection(protocol, hostname, port);
+        if (c) {
+            connections.push_back(c);
+            return c;
+        }
+    }
+    return leastLoaded;
 }
 
-HttpConnection* HttpConnectionManager::getConnection(const std::string& protocol, const std::string& hostname, const std::string& port)
+HttpConnection* HttpConnectionManager::findConnection(HttpRequest* request)
 {
     for (auto i = connections.begin(); i != connections.end(); ++i) {
-        if ((*i)->protocol == protocol && (*i)->hostname == hostname && (*i)->port == port)
+        if ((*i)->hasRequest(request))
             return *i;
     }
-    HttpConnection* c = new(std::nothrow) HttpConnection(protocol, hostname, port);
-    if (c)
-        connections.push_back(c);
-    return c;
+    return 0;
+}
+
+bool HttpConnectionManager::closeIdleConnection()
+{
+    for (auto i = connections.begin(); i != connections.end(); ++i) {
+        HttpConnection* conn = *i;
+        if (conn->isIdle() && conn->socket.is_open()) {
+            conn->idleTimer.cancel();
+            conn->close();
+            return true;
+        }
+    }
+    return false;
+}
+
+void HttpConnectionManager::dispatch()
+{
+    for (auto i = pending.begin(); i != pending.end();) {
+        HttpRequest* request = *i;
+        URI uri(request->getRequestMessage().getURL());
+        HttpConnection* conn = getConnection(uri.getProtocol(), uri.getHostname(), uri.getPort(), request->getPriority());
+        if (!conn) {
+            ++i;
+            continue;
+        }
+        i = pending.erase(i);
+        conn->send(request);
+    }
 }
 
 void HttpConnectionManager::send(HttpRequest* request)
@@ -569,9 +913,11 @@ void HttpConnectionManager::send(HttpRequest* request)
     std::string protocol = uri.getProtocol();
     std::string hostname = uri.getHostname();
     std::string port = uri.getPort();
-    HttpConnection* conn = getConnection(protocol, hostname, port);
-    if (!conn)
+    HttpConnection* conn = getConnection(protocol, hostname, port, request->getPriority());
+    if (!conn) {
+        insert(pending, request);
         return;
+    }
     conn->send(request);
 }
 
@@ -581,17 +927,19 @@ void HttpConnectionManager::abort(HttpRequest* request)
 
     if (request->getReadyState() != HttpRequest::COMPLETE) {
         if (!request->cache || !request->cache->abort(request)) {
-            URI uri(request->getRequestMessage().getURL());
-            std::string protocol = uri.getProtocol();
-            std::string hostname = uri.getHostname();
-            std::string port = uri.getPort();
-            HttpConnection* conn = getConnection(protocol, hostname, port);
-            if (conn)
+            auto found = std::find(pending.begin(), pending.end(), request);
+            if (found != pending.end()) {
+                pending.erase(found);
+                request->notify(true);
+            } else if (HttpConnection* conn = findConnection(request)) {
                 conn->abort(request);
+                dispatch();
+            }
         }
     }
     if (request->getReadyState() == HttpRequest::COMPLETE)
         completed.remove(request);
+    cancelProgress(request);
     request->notify();
 }
 
@@ -600,14 +948,226 @@ void HttpConnectionManager::done(HttpConnection* conn, bool error)
     std::lock_guard<std::recursive_mutex> lock(mutex);
 
     conn->done(this, error);
+    dispatch();
+}
+
+void HttpConnectionManager::expire(HttpConnection* conn)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    if (conn->isIdle() && conn->socket.is_open()) {
+        conn->close();
+        dispatch();
+    }
+}
+
+void HttpConnectionManager::resolve(const std::string& hostname, const std::string& port, ResolveHandler handler)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    std::string key = hostname + ':' + port;
+    auto found = hosts.find(key);
+    if (found == hosts.end()) {
+        if (MaxHostCount <= hosts.size())
+            expireHosts();
+        found = hosts.insert(std::make_pair(key, HostEntry())).first;
+    }
+    HostEntry& entry(found->second);
+    if (!entry.waiting.empty()) {
+        entry.waiting.push_back(handler);
+        return;
+    }
+    if (std::chrono::steady_clock::now() < entry.expires) {
+        if (handler)
+            ioService.post(boost::bind(handler, entry.error, entry.endpoints));
+        return;
+    }
+    entry.waiting.push_back(handler);
+    boost::asio::ip::tcp::resolver::query query(hostname, port);
+    resolver.async_resolve(query,
+                           boost::bind(&HttpConnectionManager::handleResolve, this, key,
+                                       boost::asio::placeholders::error,
+                                       boost::asio::placeholders::iterator));
+}
+
+void HttpConnectionManager::handleResolve(const std::string& key, const boost::system::error_code& err, boost::asio::ip::tcp::resolver::iterator endpoints)
+{
+    std::list<ResolveHandler> waiting;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+
+        HostEntry& entry(hosts[key]);
+        entry.error = err;
+        entry.endpoints = endpoints;
+        if (err == boost::asio::error::operation_aborted)
+            entry.expires = std::chrono::steady_clock::time_point();
+        else
+            entry.expires = std::chrono::steady_clock::now() + std::chrono::seconds(err ? NegativeHostTimeToLive : HostTimeToLive);
+        waiting.swap(entry.waiting);
+    }
+    for (auto i = waiting.begin(); i != waiting.end(); ++i) {
+        if (*i)
+            (*i)(err, endpoints);
+    }
+}
+
+void HttpConnectionManager::expireHosts()
+{
+    auto now = std::chrono::steady_clock::now();
+    for (auto i = hosts.begin(); i != hosts.end();) {
+        if (i->second.waiting.empty() && i->second.expires <= now)
+            i = hosts.erase(i);
+        else
+            ++i;
+    }
+}
+
+void HttpConnectionManager::initializeSSL()
+{
+    sslContext.set_options(boost::asio::ssl::context::default_workarounds | boost::asio::ssl::context::no_sslv2);
+    sslContext.set_default_verify_paths();
+    // Keep the sessions by ourselves to look them up by the server.
+    SSL_CTX* ctx = sslContext.native_handle();
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx, handleNewSession);
+}
+
+// Called by OpenSSL when a session is established. With TLS 1.3, this
+// happens after the handshake upon receiving a session ticket.
+int HttpConnectionManager::handleNewSession(SSL* ssl, SSL_SESSION* session)
+{
+    HttpConnection* conn = static_cast<HttpConnection*>(SSL_get_app_data(ssl));
+    if (!conn)
+        return 0;
+    getInstance().storeSession(conn->hostname + ':' + conn->port, session);
+    return 1;   // the reference to session is taken
+}
+
+void HttpConnectionManager::storeSession(const std::string& key, SSL_SESSION* session)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    auto found = sessions.find(key);
+    if (found != sessions.end()) {
+        SSL_SESSION_free(found->second);
+        found->second = session;
+        return;
+    }
+    if (MaxSessionCount <= sessions.size()) {
+        for (auto i = sessions.begin(); i != sessions.end(); ++i)
+            SSL_SESSION_free(i->second);
+        sessions.clear();
+    }
+    sessions[key] = session;
+}
+
+void HttpConnectionManager::resumeSession(SSL* ssl, const std::string& hostname, const std::string& port)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    auto found = sessions.find(hostname + ':' + port);
+    if (found != sessions.end())
+        SSL_set_session(ssl, found->second);
+}
+
+void HttpConnectionManager::preconnect(const URL& url)
+{
+    if (!url.testProtocol(u"http") && !url.testProtocol(u"https"))
+        return;
+
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    URI uri(url);
+    std::string protocol = uri.getProtocol();
+    std::string hostname = uri.getHostname();
+    std::string port = uri.getPort();
+    HttpConnection* closed = 0;
+    unsigned active = 0;
+    for (auto i = connections.begin(); i != connections.end(); ++i) {
+        HttpConnection* conn = *i;
+        if (conn->isActive())
+            ++active;
+        if (conn->protocol != protocol || conn->hostname != hostname || conn->port != port)
+            continue;
+        if (conn->state != HttpConnection::Closed || !conn->isIdle())
+            return;     // connected or being connected already
+        closed = conn;
+    }
+    // Do not close other connections for a speculative one.
+    if (maxConnections <= active)
+        return;
+    if (!closed) {
+        closed = new(std::nothrow) HttpConnection(protocol, hostname, port);
+        if (!closed)
+            return;
+        connections.push_back(closed);
+    }
+    closed->connect();
+}
+
+void HttpConnectionManager::preresolve(const URL& url)
+{
+    if (!url.testProtocol(u"http") && !url.testProtocol(u"https"))
+        return;
+    URI uri(url);
+    resolve(uri.getHostname(), uri.getPort(), ResolveHandler());
 }
 
 void HttpConnectionManager::complete(HttpRequest* request, bool error)
 {
+    // The rest of the content is notified by HttpRequest::notify().
+    cancelProgress(request);
     if (request->complete(error))
         completed.push_back(request);
 }
 
+void HttpConnectionManager::load(HttpRequest* request)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    // Keep the values taken first; a resumed response is merged into the
+    // same representation.
+    if (request->readyState == HttpRequest::LOADING)
+        return;
+    HttpResponseMessage& responseMessage = request->getResponseMessage();
+    responseMessage.getLastModifiedValue(request->lastModified);
+    request->contentCharset = responseMessage.getContentCharset();
+    request->readyState = HttpRequest::LOADING;
+}
+
+void HttpConnectionManager::progress(HttpRequest* request)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    if (!request->progressQueued) {
+        request->progressQueued = true;
+        progressing.push_back(request);
+    }
+}
+
+void HttpConnectionManager::cancelProgress(HttpRequest* request)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    if (request->progressQueued) {
+        request->progressQueued = false;
+        progressing.remove(request);
+    }
+}
+
+HttpRequest* HttpConnectionManager::getProgressing()
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    if (!progressing.empty()) {
+        HttpRequest* request = progressing.front();
+        progressing.pop_front();
+        request->progressQueued = false;
+        return request;
+    }
+    return 0;
+}
+
 HttpRequest* HttpConnectionManager::getCompleted()
 {
     std::lock_guard<std::recursive_mutex> lock(mutex);
@@ -622,6 +1182,8 @@ HttpRequest* HttpConnectionManager::getCompleted()
 
 void HttpConnectionManager::poll()
 {
+    while (HttpRequest* request = getProgressing())
+        request->notifyProgress();
     while (HttpRequest* request = getCompleted())
         request->notify();
 }
@@ -631,11 +1193,19 @@ void HttpConnectionManager::operator()()
     ioService.run();
 }
 
+HttpConnectionManager::~HttpConnectionManager()
+{
+    for (auto i = sessions.begin(); i != sessions.end(); ++i)
+        SSL_SESSION_free(i->second);
+}
+
 void HttpConnectionManager::dump()
 {
     HttpConnectionManager& instance(getInstance());
     for (auto i = instance.connections.begin(); i != instance.connections.end(); ++i)
         (*i)->dump();
+    std::cout << "pending: " << instance.pending.size() << '\n';
+    std::cout << "progressing: " << instance.progressing.size() << '\n';
     std::cout << "completed: " << instance.completed.size() << '\n';
 }
 
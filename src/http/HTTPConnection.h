@@ -17,14 +17,21 @@
 #ifndef ES_HTTP_CONNECTION_H
 #define ES_HTTP_CONNECTION_H
 
+#include <algorithm>
+#include <chrono>
 #include <list>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <thread>
 
 #include <boost/asio.hpp>
 #include <boost/asio/ssl.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
 
 #include "http/HTTPCache.h"
+#include "http/HTTPContentDecoder.h"
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
@@ -32,34 +39,127 @@ class HttpConnection;
 
 class HttpConnectionManager
 {
+    friend class HttpRequest;
+
+public:
+    typedef boost::function<void (const boost::system::error_code&, boost::asio::ip::tcp::resolver::iterator)> ResolveHandler;
+
+private:
+    static const unsigned DefaultMaxConnectionsPerHost = 6;
+    static const unsigned DefaultMaxConnections = 16;
+
+    // getaddrinfo() does not tell the TTL of the records.
+    static const int HostTimeToLive = 60;           // in seconds
+    static const int NegativeHostTimeToLive = 10;   // in seconds
+    static const size_t MaxHostCount = 256;
+    static const size_t MaxSessionCount = 256;
+
+    // The result of resolving a host name
+    struct HostEntry
+    {
+        boost::system::error_code error;
+        boost::asio::ip::tcp::resolver::iterator endpoints;
+        std::chrono::steady_clock::time_point expires;
+        std::list<ResolveHandler> waiting;  // not empty while being resolved
+    };
+
     std::recursive_mutex mutex;
     std::list<HttpConnection*> connections;
+    std::list<HttpRequest*> pending;    // waiting for a connection to become available
     std::list<HttpRequest*> completed;
+    std::list<HttpRequest*> progressing;    // with newly received content
+
+    unsigned maxConnectionsPerHost;
+    unsigned maxConnections;
+    bool pipelining;
 
     boost::asio::io_service ioService;
     boost::asio::ip::tcp::resolver resolver;
     boost::asio::io_service::work work;
 
+    std::map<std::string, HostEntry> hosts;     // by "hostname:port"
+
+    // The verify paths of the shared SSL context are loaded only once.
+    boost::asio::ssl::context sslContext;
+    std::map<std::string, SSL_SESSION*> sessions;  // by "hostname:port"
+
     HttpRequest* getCompleted();
+    HttpRequest* getProgressing();
+    void cancelProgress(HttpRequest* request);
+    HttpConnection* findConnection(HttpRequest* request);
+    bool closeIdleConnection();
+    void dispatch();
+    void expireHosts();
+    void handleResolve(const std::string& key, const boost::system::error_code& err, boost::asio::ip::tcp::resolver::iterator endpoints);
+
+    void initializeSSL();
+    void storeSession(const std::string& key, SSL_SESSION* session);
+    static int handleNewSession(SSL* ssl, SSL_SESSION* session);
 
 public:
     HttpConnectionManager() :
+        maxConnectionsPerHost(DefaultMaxConnectionsPerHost),
+        maxConnections(DefaultMaxConnections),
+        pipelining(false),
         resolver(ioService),
-        work(ioService)
+        work(ioService),
+        sslContext(boost::asio::ssl::context::sslv23)
     {
+        initializeSSL();
+    }
+    ~HttpConnectionManager();
+
+    // Sets the maximum number of the persistent connections per host, and
+    // in total.
+    void setMaxConnections(unsigned perHost, unsigned total) {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        maxConnectionsPerHost = std::max(1u, perHost);
+        maxConnections = std::max(maxConnectionsPerHost, total);
     }
 
-    HttpConnection* getConnection(const std::string& protocol, const std::string& hostname, const std::string& port);
+    // Enables HTTP/1.1 pipelining on the connections that have proven to
+    // be persistent.
+    void setPipelining(bool value) {
+        pipelining = value;
+    }
+    bool isPipelining() const {
+        return pipelining;
+    }
+
+    // Returns the least loaded connection to the specified host for a
+    // request of the specified priority, or 0 if no more connection can be
+    // opened for now.
+    HttpConnection* getConnection(const std::string& protocol, const std::string& hostname, const std::string& port, unsigned short priority = HttpRequest::DEFAULT_PRIORITY);
     void send(HttpRequest* request);
     void abort(HttpRequest* request);
     void done(HttpConnection* conn, bool error);
+    void expire(HttpConnection* conn);
     void complete(HttpRequest* request, bool error);
+    // Lets the content of the request be processed while it is being
+    // downloaded. The values the main thread reads meanwhile are taken from
+    // the response headers here.
+    void load(HttpRequest* request);
+    // Schedules the request for notifying its progress handler.
+    void progress(HttpRequest* request);
     void poll();
 
-    template <typename ResolveHandler>
-    void resolve(const boost::asio::ip::tcp::resolver::query& q, ResolveHandler handler) {
-        resolver.async_resolve(q,handler);
+    // Resolves the host name through the cache of the recent results,
+    // including the failed ones. The handler is called from the I/O thread.
+    void resolve(const std::string& hostname, const std::string& port, ResolveHandler handler);
+
+    // Opens a connection to the origin of the specified URL ahead of the
+    // first request to it.
+    void preconnect(const URL& url);
+    // Resolves the host name of the specified URL ahead of the first
+    // request to it.
+    void preresolve(const URL& url);
+
+    boost::asio::ssl::context& getSSLContext() {
+        return sslContext;
     }
+    // Lets the new connection resume the last TLS session with the same
+    // server.
+    void resumeSession(SSL* ssl, const std::string& hostname, const std::string& port);
 
     void operator()();
     void stop() {
@@ -89,7 +189,6 @@ class HttpConnection
         Resolved,
         Connected,
         Handshaking,
-        ReadStatusLine,
         ReadHead,
         ReadContent,
         ReadChunk,
@@ -99,11 +198,18 @@ class HttpConnection
 
     static const char* States[];
 
+    typedef boost::asio::ssl::stream<boost::asio::ip::tcp::socket&> SecureSocket;
+
     static const int MaxRetryCount = 3;
+    static const int KeepAliveTimeout = 30;  // in seconds
+    static const size_t MaxPipelineDepth = 4;
+    static const size_t MaxHeadSize = 64 * 1024;  // for the response head and each chunk-size line
 
     int state;
     int retryCount;
-    std::string line;  // line buffer
+    bool persistent;   // true if a response has been received with keep-alive
+    bool pipelined;    // true if the request for current has been sent along with the previous one
+    size_t scanned;    // the octets of response scanned for the end of the head or the line
 
     std::string protocol;
     std::string hostname;
@@ -114,44 +220,100 @@ class HttpConnection
     boost::asio::streambuf request;
     boost::asio::streambuf response;
 
-    boost::asio::ssl::context context;
-    boost::asio::ssl::stream<boost::asio::ip::tcp::socket&> secureSocket;
+    std::shared_ptr<SecureSocket> secureSocket;  // for each handshake; shared with the pending handlers
+
+    boost::asio::deadline_timer idleTimer;
 
     unsigned long long octetCount;
     unsigned long long contentLength;
 
     // chunked
     unsigned long long chunkLength;
+    bool chunkData;    // true while reading chunk-data and the following CRLF
     int chunkCRLF;
 
-    std::list<HttpRequest*> requests;
+    HttpContentDecoder decoder;
+
+    std::list<HttpRequest*> requests;  // sorted by priority
+    std::list<HttpRequest*> pipeline;  // sent after current
+    std::list<HttpRequest*> standIns;  // reading the responses to the aborted requests in pipeline
     HttpRequest* current;
 
+    void connect();
+    bool createSecureSocket();
+    void keepAlive();
     void sendRequest();
+    void readNext();
+    bool canPipeline(HttpRequest* request);
 
     void handleResolve(const boost::system::error_code& err, boost::asio::ip::tcp::resolver::iterator endpointIterator);
     void handleConnect(const boost::system::error_code& err, boost::asio::ip::tcp::resolver::iterator endpointIterator);
     void handleHandshake(const boost::system::error_code& err);
     void handleWriteRequest(const boost::system::error_code& err);
     void handleRead(const boost::system::error_code& err);
+    void handleIdleTimeout(const boost::system::error_code& err);
 
-    void readStatusLine(const boost::system::error_code& err);
     void readHead(const boost::system::error_code& err);
+    void processHead(const boost::system::error_code& err);
     void readContent(const boost::system::error_code& err);
     void readChunk(const boost::system::error_code& err);
     void readTrailer(const boost::system::error_code& err);
 
+    bool writeContent(const char* data, size_t length);
+    bool finishContent(HttpRequest* request);
+    bool mergeContent(unsigned long long& offset);
+    bool restoreContent(const std::string& path, unsigned long long length);
+
     void close();
     void retry();
+    bool resume();
+    bool discard(HttpRequest* request);
+    bool isStandIn(HttpRequest* request) const {
+        return std::find(standIns.begin(), standIns.end(), request) != standIns.end();
+    }
+    void dropStandIn(HttpRequest* request);
 
     void send(HttpRequest* request);
     void abort(HttpRequest* request);
     void done(HttpConnectionManager* manager, bool error);
 
+    bool isIdle() const {
+        return !current && requests.empty() && pipeline.empty();
+    }
+    bool isActive() const {
+        return !isIdle() || socket.is_open();
+    }
+    // Returns the number of the requests that precede a new request of
+    // the specified priority.
+    size_t getLoad(unsigned short priority = HttpRequest::LOW_PRIORITY) const {
+        size_t load = pipeline.size() + (current ? 1 : 0);
+        for (auto i = requests.begin(); i != requests.end() && (*i)->getPriority() <= priority; ++i)
+            ++load;
+        return load;
+    }
+    bool hasRequest(HttpRequest* request) const {
+        return current == request ||
+               std::find(requests.begin(), requests.end(), request) != requests.end() ||
+               std::find(pipeline.begin(), pipeline.end(), request) != pipeline.end();
+    }
+
+    // Keeps the SSL stream alive until the handler of an operation on it is
+    // called, even after the stream has been replaced for a new handshake.
+    typedef boost::function<void (const boost::system::error_code&)> SecureHandler;
+    static void handleSecure(std::shared_ptr<SecureSocket> stream, SecureHandler handler, const boost::system::error_code& err) {
+        handler(err);
+    }
+
+    void asyncHandshake(SecureHandler handler) {
+        secureSocket->async_handshake(boost::asio::ssl::stream_base::client,
+                                      boost::bind(&HttpConnection::handleSecure, secureSocket, handler, boost::asio::placeholders::error));
+    }
+
     template<typename CompletionCondition, typename ReadHandler>
     void asyncRead(boost::asio::streambuf& buffers, CompletionCondition completionCondition, ReadHandler handler) {
         if (protocol == "https:")
-            boost::asio::async_read(secureSocket, buffers, completionCondition, handler);
+            boost::asio::async_read(*secureSocket, buffers, completionCondition,
+                                    boost::bind(&HttpConnection::handleSecure, secureSocket, SecureHandler(handler), boost::asio::placeholders::error));
         else
             boost::asio::async_read(socket, buffers, completionCondition, handler);
     }
@@ -159,7 +321,8 @@ class HttpConnection
     template<typename WriteHandler>
     void asyncWrite(boost::asio::streambuf& buffers, WriteHandler handler) {
         if (protocol == "https:")
-            boost::asio::async_write(secureSocket, buffers, handler);
+            boost::asio::async_write(*secureSocket, buffers,
+                                     boost::bind(&HttpConnection::handleSecure, secureSocket, SecureHandler(handler), boost::asio::placeholders::error));
         else
             boost::asio::async_write(socket, buffers, handler);
     }
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HTTPContentDecoder.h"
+
+#include <string.h>
+
+#include "http/HTTPUtil.h"
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+using namespace http;
+
+HttpContentDecoder::HttpContentDecoder() :
+    coding(Identity),
+    initialized(false),
+    finished(false)
+{
+    memset(&stream, 0, sizeof stream);
+}
+
+HttpContentDecoder::~HttpContentDecoder()
+{
+    close();
+}
+
+bool HttpContentDecoder::open(const std::string& contentEncoding)
+{
+    close();
+    std::string value(contentEncoding);
+    trimLWS(value);
+    toLowerCase(value);
+    if (value.empty() || value == "identity")
+        return true;
+    if (value == "gzip" || value == "x-gzip")
+        coding = Gzip;
+    else if (value == "deflate")
+        coding = Deflate;
+    else
+        return false;
+    return true;
+}
+
+void HttpContentDecoder::close()
+{
+    if (initialized)
+        inflateEnd(&stream);
+    memset(&stream, 0, sizeof stream);
+    coding = Identity;
+    head.clear();
+    initialized = false;
+    finished = false;
+}
+
+bool HttpContentDecoder::initialize(const unsigned char* data, size_t length)
+{
+    int windowBits;
+    if (coding == Gzip)
+        windowBits = 16 + MAX_WBITS;
+    else {
+        // Some servers send a raw deflate stream without the zlib wrapper.
+        // cf. http://tools.ietf.org/html/rfc1950#section-2.2
+        if ((data[0] & 0x0f) == Z_DEFLATED && ((data[0] << 8) | data[1]) % 31 == 0)
+            windowBits = MAX_WBITS;
+        else
+            windowBits = -MAX_WBITS;
+    }
+    if (inflateInit2(&stream, windowBits) != Z_OK)
+        return false;
+    initialized = true;
+    return true;
+}
+
+long long HttpContentDecoder::write(std::ostream& content, const char* data, size_t length)
+{
+    if (coding == Identity) {
+        content.write(data, length);
+        return content ? length : -1;
+    }
+    if (finished || length == 0)
+        return 0;
+    if (!initialized) {
+        if (coding == Deflate && head.length() + length < 2) {
+            head.append(data, length);    // wait for the zlib header
+            return 0;
+        }
+        if (!head.empty()) {
+            std::string s(head);
+            s.append(data, length);
+            head.clear();
+            return write(content, s.c_str(), s.length());
+        }
+        if (!initialize(reinterpret_cast<const unsigned char*>(data), length))
+            return -1;
+    }
+
+    long long count = 0;
+    unsigned char buffer[BufferSize];
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream.avail_in = length;
+    do {
+        stream.next_out = buffer;
+        stream.avail_out = BufferSize;
+        int result = inflate(&stream, Z_NO_FLUSH);
+        switch (result) {
+        case Z_OK:
+        case Z_BUF_ERROR:
+            break;
+        case Z_STREAM_END:
+            finished = true;
+            break;
+        default:
+            return -1;
+        }
+        size_t size = BufferSize - stream.avail_out;
+        if (0 < size) {
+            content.write(reinterpret_cast<const char*>(buffer), size);
+            if (!content)
+                return -1;
+            count += size;
+        }
+        if (result == Z_BUF_ERROR && stream.avail_out)
+            break;
+    } while (!finished && (stream.avail_in || !stream.avail_out));
+    return count;
+}
+
+}}}}  // org::w3c::dom::bootstrap
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES_HTTP_CONTENTDECODER_H
+#define ES_HTTP_CONTENTDECODER_H
+
+#include <zlib.h>
+
+#include <ostream>
+#include <string>
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+// HttpContentDecoder decodes the gzip or deflate content-coding.
+// cf. http://tools.ietf.org/html/rfc2616#section-3.5
+class HttpContentDecoder
+{
+public:
+    // codings
+    enum {
+        Identity,
+        Gzip,
+        Deflate
+    };
+
+private:
+    static const size_t BufferSize = 16384;
+
+    int coding;
+    bool initialized;
+    bool finished;
+    z_stream stream;
+    std::string head;  // the first octet of a deflate stream
+
+    bool initialize(const unsigned char* data, size_t length);
+
+public:
+    HttpContentDecoder();
+    ~HttpContentDecoder();
+
+    // Starts decoding the content of the specified Content-Encoding. Returns
+    // false if the coding is not supported, in which case the content is
+    // passed through.
+    bool open(const std::string& contentEncoding);
+    void close();
+
+    int getCoding() const {
+        return coding;
+    }
+    bool isFinished() const {
+        return finished;
+    }
+    // Returns true if the encoded content has ended before the end of the
+    // compressed stream.
+    bool isTruncated() const {
+        return (initialized || !head.empty()) && !finished;
+    }
+
+    // Writes the decoded data to content and returns the number of octets
+    // written, or -1 upon error.
+    long long write(std::ostream& content, const char* data, size_t length);
+};
+
+}}}}  // org::w3c::dom::bootstrap
+
+#endif  // ES_HTTP_CONTENTDECODER_H
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HTTPContentSpan.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+namespace {
+
+class Unmapper
+{
+    size_t length;
+public:
+    Unmapper(size_t length) :
+        length(length)
+    {
+    }
+    void operator()(const void* address) const {
+        munmap(const_cast<void*>(address), length);
+    }
+};
+
+}  // namespace
+
+HttpContentSpan::HttpContentSpan(const std::shared_ptr<std::string>& buffer) :
+    owner(buffer),
+    data(buffer ? buffer->data() : 0),
+    length(buffer ? buffer->length() : 0)
+{
+}
+
+HttpContentSpan HttpContentSpan::map(const std::string& path)
+{
+    HttpContentSpan span;
+    int fd = ::open(path.c_str(), O_RDONLY, 0);
+    if (fd == -1)
+        return span;
+    struct stat status;
+    if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode)) {
+        if (status.st_size == 0)
+            span.data = "";
+        else {
+            void* address = mmap(0, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED) {
+                try {
+                    span.owner.reset(address, Unmapper(status.st_size));
+                    span.data = static_cast<const char*>(address);
+                    span.length = status.st_size;
+                } catch (...) {
+                    // reset() has already unmapped the address.
+                }
+            }
+        }
+    }
+    close(fd);
+    return span;
+}
+
+}}}}  // org::w3c::dom::bootstrap
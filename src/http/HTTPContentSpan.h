@@ -0,0 +1,67 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES_HTTP_CONTENTSPAN_H
+#define ES_HTTP_CONTENTSPAN_H
+
+#include <memory>
+#include <string>
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+// HttpContentSpan is a read-only view of the content of a completed request,
+// either kept in memory or mapped from the file. The content stays valid as
+// long as any copy of the span is alive, even after the file is removed.
+class HttpContentSpan
+{
+    std::shared_ptr<const void> owner;
+    const char* data;
+    size_t length;
+
+public:
+    HttpContentSpan() :
+        data(0),
+        length(0)
+    {
+    }
+    explicit HttpContentSpan(const std::shared_ptr<std::string>& buffer);
+
+    // Maps the specified file into memory. Returns an invalid span upon error.
+    static HttpContentSpan map(const std::string& path);
+
+    bool isValid() const {
+        return data;
+    }
+    const char* begin() const {
+        return data;
+    }
+    const char* end() const {
+        return data + length;
+    }
+    size_t size() const {
+        return length;
+    }
+
+    void clear() {
+        owner.reset();
+        data = 0;
+        length = 0;
+    }
+};
+
+}}}}  // org::w3c::dom::bootstrap
+
+#endif  // ES_HTTP_CONTENTSPAN_H
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2013 Esrille Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ES_HTTP_CONTENTSTREAM_H
+#define ES_HTTP_CONTENTSTREAM_H
+
+#include <istream>
+#include <memory>
+#include <string>
+
+#include <boost/iostreams/stream_buffer.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/file_descriptor.hpp>
+
+#include "http/HTTPContentSpan.h"
+#include "http/HTTPRequest.h"
+
+namespace org { namespace w3c { namespace dom { namespace bootstrap {
+
+// HttpContentStream reads the content of a request. The content of a
+// completed request is read directly from its HttpContentSpan; otherwise it
+// is read from the file while it is being downloaded.
+class HttpContentStream : public std::istream
+{
+    HttpContentSpan span;
+    boost::iostreams::stream_buffer<boost::iostreams::array_source> memory;
+    boost::iostreams::stream_buffer<boost::iostreams::file_descriptor_source> file;
+
+public:
+    explicit HttpContentStream(HttpRequest& request) :
+        std::istream(0)
+    {
+        if (HttpRequest::COMPLETE <= request.getReadyState()) {
+            span = request.getContentSpan();
+            if (span.isValid()) {
+                memory.open(boost::iostreams::array_source(span.begin(), span.size()));
+                rdbuf(&memory);
+                return;
+            }
+        }
+        int fd = request.getContentDescriptor();
+        if (fd == -1)
+            return;
+        file.open(boost::iostreams::file_descriptor_source(fd, boost::iostreams::close_handle));
+        rdbuf(&file);
+    }
+};
+
+}}}}  // org::w3c::dom::bootstrap
+
+#endif  // ES_HTTP_CONTENTSTREAM_H
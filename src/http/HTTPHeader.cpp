@@ -28,38 +28,110 @@ inline bool isLWS(int c)
     return c == '\n' || c == '\r' || c == '\t' || c == ' ';
 }
 
-bool canCommaSeparated(const std::string& header)
-{
-    const char* names[] = {
-        "Accept",
-        "Accept-Charset",
-        "Accept-Encoding",
-        "Accept-Language",
-        "Accept-Ranges",
-        "Allow",
-        "Cache-Control",
-        "Connection",
-        "Content-Encoding",
-        "Content-Language",
-        "Expect",
-        "If-Match",
-        "If-None-Match",
-        "Pragma",
-        "TE",
-        "Trailer",
-        "Transfer-Encoding",
-        "Upgrade",
-        "Vary",
-        "Via",
-        "Warning",
-        0
-    };
-    const char* h = header.c_str();
-    for (const char** i = names; *i; ++i) {
-        if (strcasecmp(*i, h) == 0)
-            return true;
+using org::w3c::dom::bootstrap::HttpHeader;
+
+// in the order of the IDs
+const char* names[HttpHeader::KnownCount] = {
+    "Accept",
+    "Accept-Charset",
+    "Accept-Encoding",
+    "Accept-Language",
+    "Accept-Ranges",
+    "Age",
+    "Allow",
+    "Cache-Control",
+    "Connection",
+    "Content-Encoding",
+    "Content-Language",
+    "Content-Length",
+    "Content-Range",
+    "Content-Type",
+    "Date",
+    "ETag",
+    "Expect",
+    "Expires",
+    "Host",
+    "If-Match",
+    "If-Modified-Since",
+    "If-None-Match",
+    "If-Range",
+    "Keep-Alive",
+    "Last-Modified",
+    "Location",
+    "Pragma",
+    "Proxy-Authenticate",
+    "Proxy-Authorization",
+    "Range",
+    "TE",
+    "Trailer",
+    "Transfer-Encoding",
+    "Upgrade",
+    "Vary",
+    "Via",
+    "Warning"
+};
+
+// An open addressing table of the well-known names by their hash values
+class NameTable
+{
+    static const unsigned Size = 128;   // a power of two larger than KnownCount
+    signed char table[Size];
+
+public:
+    NameTable() {
+        std::fill(table, table + Size, -1);
+        for (int id = 0; id < HttpHeader::KnownCount; ++id) {
+            unsigned i = HttpHeader::hash(names[id], strlen(names[id]));
+            while (0 <= table[i % Size])
+                ++i;
+            table[i % Size] = id;
+        }
+    }
+    int find(const char* name, size_t length) const {
+        for (unsigned i = HttpHeader::hash(name, length);; ++i) {
+            int id = table[i % Size];
+            if (id < 0)
+                return HttpHeader::Other;
+            if (strncasecmp(names[id], name, length) == 0 && names[id][length] == '\0')
+                return id;
+        }
+    }
+};
+
+const NameTable& getNameTable()
+{
+    static NameTable table;
+    return table;
+}
+
+bool canCommaSeparated(int id)
+{
+    switch (id) {
+    case HttpHeader::Accept:
+    case HttpHeader::AcceptCharset:
+    case HttpHeader::AcceptEncoding:
+    case HttpHeader::AcceptLanguage:
+    case HttpHeader::AcceptRanges:
+    case HttpHeader::Allow:
+    case HttpHeader::CacheControl:
+    case HttpHeader::Connection:
+    case HttpHeader::ContentEncoding:
+    case HttpHeader::ContentLanguage:
+    case HttpHeader::Expect:
+    case HttpHeader::IfMatch:
+    case HttpHeader::IfNoneMatch:
+    case HttpHeader::Pragma:
+    case HttpHeader::TE:
+    case HttpHeader::Trailer:
+    case HttpHeader::TransferEncoding:
+    case HttpHeader::Upgrade:
+    case HttpHeader::Vary:
+    case HttpHeader::Via:
+    case HttpHeader::Warning:
+        return true;
+    default:
+        return false;
     }
-    return false;
 }
 
 }
@@ -68,11 +140,80 @@ namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
 using namespace http;
 
+unsigned HttpHeader::hash(const char* name, size_t length)
+{
+    // FNV-1a over the lower-cased name
+    unsigned h = 2166136261u;
+    for (const char* end = name + length; name < end; ++name)
+        h = (h ^ static_cast<unsigned char>(tolower(*name))) * 16777619u;
+    return h;
+}
+
+int HttpHeader::getID(const char* name, size_t length)
+{
+    return getNameTable().find(name, length);
+}
+
+const char* HttpHeader::getName(int id)
+{
+    return (0 <= id && id < KnownCount) ? names[id] : 0;
+}
+
+int HttpHeaderList::find(int id, const char* header, size_t length) const
+{
+    if (id != HttpHeader::Other)
+        return known[id];
+    auto range = others.equal_range(HttpHeader::hash(header, length));
+    for (auto i = range.first; i != range.second; ++i) {
+        const HttpHeader& h(headers[i->second]);
+        if (h.header.length() == length && strncasecmp(h.header.c_str(), header, length) == 0)
+            return i->second;
+    }
+    return -1;
+}
+
+HttpHeader& HttpHeaderList::append(int id, const char* header, size_t length)
+{
+    size_t index = headers.size();
+    headers.push_back(HttpHeader());
+    HttpHeader& h(headers.back());
+    h.id = id;
+    h.header.assign(header, length);
+    if (id != HttpHeader::Other)
+        known[id] = index;
+    else
+        others.insert(std::make_pair(HttpHeader::hash(header, length), index));
+    return h;
+}
+
+void HttpHeaderList::remove(size_t index)
+{
+    headers.erase(headers.begin() + index);
+    // Fields are removed rarely; simply rebuild the indices.
+    std::fill(known, known + HttpHeader::KnownCount, -1);
+    others.clear();
+    for (size_t i = 0; i < headers.size(); ++i) {
+        const HttpHeader& h(headers[i]);
+        if (h.id != HttpHeader::Other)
+            known[h.id] = i;
+        else
+            others.insert(std::make_pair(HttpHeader::hash(h.header.c_str(), h.header.length()), i));
+    }
+}
+
 bool HttpHeaderList::get(const std::string& header, std::string& value) const
 {
-    auto it = std::find(headers.begin(), headers.end(), header);
-    if (it != headers.end()) {
-        value = it->value;
+    int index = find(HttpHeader::getID(header), header.c_str(), header.length());
+    if (index < 0)
+        return false;
+    value = headers[index].value;
+    return true;
+}
+
+bool HttpHeaderList::get(int id, std::string& value) const
+{
+    if (const std::string* v = find(id)) {
+        value = *v;
         return true;
     }
     return false;
@@ -80,67 +221,68 @@ bool HttpHeaderList::get(const std::string& header, std::string& value) const
 
 void HttpHeaderList::erase(const std::string& header)
 {
-    auto it = std::find(headers.begin(), headers.end(), header);
-    if (it != headers.end())
-        headers.erase(it);
+    int index = find(HttpHeader::getID(header), header.c_str(), header.length());
+    if (0 <= index)
+        remove(index);
 }
 
 void HttpHeaderList::set(const std::string& header, const std::string& value, bool merge)
 {
-    std::string v = value;
+    set(HttpHeader(header, value), merge);
+}
+
+void HttpHeaderList::set(const HttpHeader& header, bool merge)
+{
+    std::string v = header.value;
     trimLWS(v);
-    auto it = std::find(headers.begin(), headers.end(), header);
+    int index = find(header.id, header.header.c_str(), header.header.length());
     if (v.empty()) {
-        if (!merge && it != headers.end())
-            headers.erase(it);
+        if (!merge && 0 <= index)
+            remove(index);
         return;
     }
-    if (it == headers.end()) {
-        headers.push_back(HttpHeader{header, v});
+    if (index < 0) {
+        append(header.id, header.header.c_str(), header.header.length()).value = v;
         return;
     }
-    if (merge && canCommaSeparated(header)) {
-        it->value += ", " + v;
+    if (merge && canCommaSeparated(header.id)) {
+        headers[index].value += ", " + v;
         return;
     }
-    it->value = v;  // replace the existing value
+    headers[index].value = v;  // replace the existing value
 }
 
-const char* HttpHeaderList::parseLine(const char* start, const char* const end, HttpHeader* p)
+const char* HttpHeaderList::parseLine(const char* start, const char* const end, const HttpHeader** p)
 {
+    const char* eol = findLF(start, end);
+    if (eol == end)
+        return 0;
     const char* name = start;
-    const char* colon = 0;
-    while (start < end) {
-        if (*start == ':') {
-            colon = start++;
-            break;
-        }
-        ++start;
-    }
+    const char* colon = static_cast<const char*>(memchr(name, ':', eol - name));
     if (!colon || !isValidToken(name, colon))
         return 0;
-    const char* field = start;
-    const char* eol = field;
+    const char* field = colon + 1;
     const char* eof = eol;
-    while (eol < end) {
-        char c = *eol;
-        if (c == '\n')  // LF?
-            break;
-        if (!isLWS(c)) {
-            eof = eol + 1;
-            if (field == start)
-                field = eol;
-        }
-        ++eol;
+    while (field < eof && isLWS(*field))
+        ++field;
+    while (field < eof && isLWS(eof[-1]))
+        --eof;
+
+    // Store the field without constructing temporary strings.
+    int id = HttpHeader::getID(name, colon - name);
+    int index = find(id, name, colon - name);
+    if (field == eof) {
+        if (0 <= index)
+            remove(index);
+        if (p)
+            *p = 0;
+        return eol + 1;
     }
-    if (*eol != '\n')
-        return 0;
-    start = eol + 1;
-    HttpHeader header(std::string(name, colon - name), std::string(field, eof - field));
-    set(header.header, header.value);
+    HttpHeader& header((index < 0) ? append(id, name, colon - name) : headers[index]);
+    header.value.assign(field, eof - field);
     if (p)
-        *p = header;
-    return start;
+        *p = &header;
+    return eol + 1;
 }
 
 bool HttpHeaderList::parse(const char* start, const char* const end)
@@ -17,19 +17,69 @@
 #ifndef ES_HTTP_HEADER_H
 #define ES_HTTP_HEADER_H
 
+#include <algorithm>
 #include <deque>
 #include <string>
 #include <cstring>
+#include <unordered_map>
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
 
 class HttpHeader
 {
 public:
+    // The IDs of the well-known header field names
+    enum {
+        Other = -1,
+        Accept,
+        AcceptCharset,
+        AcceptEncoding,
+        AcceptLanguage,
+        AcceptRanges,
+        Age,
+        Allow,
+        CacheControl,
+        Connection,
+        ContentEncoding,
+        ContentLanguage,
+        ContentLength,
+        ContentRange,
+        ContentType,
+        Date,
+        ETag,
+        Expect,
+        Expires,
+        Host,
+        IfMatch,
+        IfModifiedSince,
+        IfNoneMatch,
+        IfRange,
+        KeepAlive,
+        LastModified,
+        Location,
+        Pragma,
+        ProxyAuthenticate,
+        ProxyAuthorization,
+        Range,
+        TE,
+        Trailer,
+        TransferEncoding,
+        Upgrade,
+        Vary,
+        Via,
+        Warning,
+        KnownCount
+    };
+
+    int id;
     std::string header;
     std::string value;
-    HttpHeader() {}
+    HttpHeader() :
+        id(Other)
+    {
+    }
     HttpHeader(const std::string& header, const std::string& value) :
+        id(getID(header)),
         header(header),
         value(value)
     {
@@ -37,25 +87,57 @@ public:
     bool operator==(const std::string& header) const {
         return strcasecmp(this->header.c_str(), header.c_str()) == 0;
     }
+
+    // Returns the ID of the specified header field name, or Other.
+    static int getID(const char* name, size_t length);
+    static int getID(const std::string& name) {
+        return getID(name.c_str(), name.length());
+    }
+    static const char* getName(int id);
+    // Returns the case-insensitive hash value of the name.
+    static unsigned hash(const char* name, size_t length);
 };
 
 class HttpHeaderList
 {
     std::deque<HttpHeader> headers;
+    short known[HttpHeader::KnownCount];            // the index of each well-known field in headers, or -1
+    std::unordered_multimap<unsigned, size_t> others;   // the indices of the other fields by the hash of the name
+
+    int find(int id, const char* header, size_t length) const;
+    HttpHeader& append(int id, const char* header, size_t length);
+    void remove(size_t index);
+
 public:
+    HttpHeaderList() {
+        clear();
+    }
+
     bool get(const std::string& header, std::string& value) const;
+    bool get(int id, std::string& value) const;
+    // Returns the value of the well-known field without copying it, or
+    // null if the field is not present.
+    const std::string* find(int id) const {
+        return (0 <= known[id]) ? &headers[known[id]].value : 0;
+    }
     void set(const std::string& header, const std::string& value, bool merge = false);
+    void set(const HttpHeader& header, bool merge = false);
     void erase(const std::string& header);
 
     void clear() {
         headers.clear();
+        std::fill(known, known + HttpHeader::KnownCount, -1);
+        others.clear();
     }
 
     size_t size() const {
         return headers.size();
     }
 
-    const char* parseLine(const char* start, const char* const end, HttpHeader* p = 0);
+    // Parses a header field line in place. If p is given, it is set to the
+    // stored field, or to null if the field has been removed for its empty
+    // value.
+    const char* parseLine(const char* start, const char* const end, const HttpHeader** p = 0);
     bool parse(const char* start, const char* const end);
     std::string toString() const;
 
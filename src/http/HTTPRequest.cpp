@@ -41,47 +41,178 @@ const unsigned short HttpRequest::LOADING;
 const unsigned short HttpRequest::COMPLETE;
 const unsigned short HttpRequest::DONE;
 
+const unsigned short HttpRequest::DOCUMENT_PRIORITY;
+const unsigned short HttpRequest::BLOCKING_PRIORITY;
+const unsigned short HttpRequest::DEFAULT_PRIORITY;
+const unsigned short HttpRequest::LOW_PRIORITY;
+
 std::string HttpRequest::aboutPath;
 std::string HttpRequest::cachePath("/tmp");
 
+int HttpRequest::createTempFile(std::string& path)
+{
+    char tempPath[PATH_MAX];
+    if (PATH_MAX <= cachePath.length() + 16)
+        return -1;
+    strcpy(tempPath, cachePath.c_str());
+    strcat(tempPath, "/esrille-XXXXXX");
+    int fd = mkstemp(tempPath);
+    if (fd != -1)
+        path = tempPath;
+    return fd;
+}
+
 int HttpRequest::getContentDescriptor()
 {
-    if (filePath.empty())
+    if (buffer || filePath.empty())
         return -1;
     return ::open(filePath.c_str(), O_RDONLY, 0);
 }
 
+std::string HttpRequest::getContentCharset()
+{
+    std::lock_guard<std::recursive_mutex> lock(HttpConnectionManager::getInstance().mutex);
+    if (readyState == LOADING)
+        return contentCharset;
+    return response.getContentCharset();
+}
+
+const HttpContentSpan& HttpRequest::getContentSpan()
+{
+    if (!span.isValid() && COMPLETE <= readyState) {
+        if (buffer)
+            span = HttpContentSpan(buffer);
+        else if (!filePath.empty())
+            span = HttpContentSpan::map(filePath);
+    }
+    return span;
+}
+
+// Keeps the cache from removing filePath while this request refers to it.
+void HttpRequest::pinFile()
+{
+    if (!pinned && !filePath.empty()) {
+        HttpCacheManager::getInstance().pinFile(filePath);
+        pinned = true;
+    }
+}
+
+void HttpRequest::unpinFile()
+{
+    if (pinned) {
+        HttpCacheManager::getInstance().unpinFile(filePath);
+        pinned = false;
+    }
+}
+
+void HttpRequest::removeFile()
+{
+    if (!filePath.empty()) {
+        if (pinned)
+            unpinFile();
+        else
+            remove(filePath.c_str());
+        filePath.clear();
+    }
+    buffer.reset();
+    span.clear();
+}
+
 std::FILE* HttpRequest::openFile()
 {
+    // Let the image decoders read directly from the span.
+    if (0 < getContentSpan().size())
+        return fmemopen(const_cast<char*>(span.begin()), span.size(), "rb");
     if (filePath.empty())
         return 0;
     return fopen(filePath.c_str(), "rb");
 }
 
-std::fstream& HttpRequest::getContent()
+std::fstream& HttpRequest::createFile()
 {
-    if (content.is_open())
-        return content;
-
-    char tempPath[PATH_MAX];
-    if (PATH_MAX <= cachePath.length() + 9)
-        return content;
-    strcpy(tempPath, cachePath.c_str());
-    strcat(tempPath, "/esrille-XXXXXX");
-    int fd = mkstemp(tempPath);
-    if (fd == -1)
+    unpinFile();
+    int fd = createTempFile(filePath);
+    if (fd == -1) {
+        content.setstate(std::ios_base::failbit);
         return content;
-    filePath = tempPath;
-    content.open(tempPath, std::ios_base::trunc | std::ios_base::in | std::ios_base::out | std::ios::binary);
+    }
+    content.open(filePath.c_str(), std::ios_base::trunc | std::ios_base::in | std::ios_base::out | std::ios::binary);
     close(fd);
     return content;
 }
 
+std::ostream& HttpRequest::getContent()
+{
+    if (content.is_open())
+        return content;
+    if (buffering)
+        return memory;
+    // The content being notified to progressHandler must be readable from
+    // the file.
+    if (priority != DOCUMENT_PRIORITY && !progressHandler &&
+        (!response.hasContentLengthHeader() || response.getContentLength() <= MaxContentBufferSize)) {
+        buffering = true;
+        return memory;
+    }
+    return createFile();
+}
+
+// Moves the content to a file once it grows too large to be kept in memory.
+bool HttpRequest::flushContent()
+{
+    if (!buffering) {
+        content.flush();
+        return content.good();
+    }
+    if (!memory.flush())
+        return false;
+    if (memoryContent.length() <= MaxContentBufferSize)
+        return true;
+    std::string data;
+    data.swap(memoryContent);
+    clearContent();
+    std::fstream& file = createFile();
+    if (!file.is_open())
+        return false;
+    file.write(data.c_str(), data.length());
+    file.flush();
+    return file.good();
+}
+
+void HttpRequest::clearContent()
+{
+    if (content.is_open())
+        content.close();
+    content.clear();
+    memory.flush();
+    memory.clear();
+    memoryContent.clear();
+    buffering = false;
+    buffer.reset();
+    span.clear();
+}
+
 void HttpRequest::setHandler(boost::function<void (void)> f)
 {
     handler = f;
 }
 
+void HttpRequest::setProgressHandler(boost::function<void (unsigned long long, unsigned long long)> f)
+{
+    progressHandler = f;
+}
+
+void HttpRequest::notifyProgress()
+{
+    unsigned long long count = octetCount;
+    // The completion is notified even without any new content.
+    if (!progressHandler || (count <= progressCount && readyState != COMPLETE))
+        return;
+    unsigned long long offset = progressCount;
+    progressCount = count;
+    progressHandler(offset, count - offset);
+}
+
 void HttpRequest::clearHandler()
 {
     handler.clear();
@@ -123,14 +254,16 @@ bool HttpRequest::redirect(const HttpResponseMessage& res)
         return false;
     if (!res.shouldRedirect())
         return false;
-    std::string location = res.getResponseHeader("Location");
+    std::string location = res.getResponseHeader(HttpHeader::Location);
     if (!request.redirect(utfconv(location)))
         return false;
 
     // Redirect to location
-    if (content.is_open())
-        content.close();
+    clearContent();
+    unpinFile();
     filePath.clear();
+    octetCount = 0;
+    progressCount = 0;
     cache = 0;
     readyState = OPENED;
     return true;
@@ -140,11 +273,24 @@ bool HttpRequest::redirect(const HttpResponseMessage& res)
 bool HttpRequest::complete(bool error)
 {
     errorFlag = error;
+    if (buffering) {
+        // Hand over the content to buffer without copying it.
+        if (memory.flush() && !error) {
+            buffer = std::make_shared<std::string>();
+            buffer->swap(memoryContent);
+        }
+        memory.clear();
+        memoryContent.clear();
+        buffering = false;
+    }
     if (!error)
         response.getLastModifiedValue(lastModified);
-    else
+    else {
+        // Let the cache keep the partial content.
+        resumeResponse = response;
         response.setStatus(404);
-    readyState = (cache || handler || !callbackList.empty()) ? COMPLETE : DONE;
+    }
+    readyState = (cache || handler || progressHandler || !callbackList.empty()) ? COMPLETE : DONE;
     return readyState == COMPLETE;
 }
 
@@ -158,6 +304,8 @@ void HttpRequest::notify()
         return;
     }
 
+    if (progressHandler && !errorFlag)
+        notifyProgress();
     if (handler) {
         handler();
         handler.clear();
@@ -184,6 +332,10 @@ void HttpRequest::open(const std::u16string& method, const std::u16string& urlSt
     URL url(base, urlString);
     request.open(utfconv(method), url);
     readyState = OPENED;
+    octetCount = 0;
+    progressCount = 0;
+    resumeOffset = 0;
+    resumePath.clear();
 }
 
 void HttpRequest::setRequestHeader(const std::u16string& header, const std::u16string& value)
@@ -202,7 +354,12 @@ bool HttpRequest::constructResponseFromCache(bool sync)
     response.getLastModifiedValue(lastModified);
 
     // TODO: deal with partial...
+    unpinFile();
     filePath = cache->getFilePath();
+    pinFile();
+    buffer = cache->getContentBuffer();
+    span = cache->getContentSpan();
+    octetCount = cache->getContentLength();
 
     cache = 0;
     if (sync)
@@ -217,7 +374,7 @@ bool HttpRequest::constructResponseFromCache(bool sync)
 
 namespace {
 
-bool decodeBase64(std::fstream& content, const std::string& data)
+bool decodeBase64(std::ostream& content, const std::string& data)
 {
     static const char* const table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
     char buf[4];
@@ -265,8 +422,8 @@ bool HttpRequest::constructResponseFromData()
         base64 = true;
     }
     response.parseMediaType(data.c_str() + 5, data.c_str() + end);
-    std::fstream& content = getContent();
-    if (!content.is_open()) {
+    std::ostream& content = getContent();
+    if (!content) {
         notify(true);
         return errorFlag;
     }
@@ -280,7 +437,10 @@ bool HttpRequest::constructResponseFromData()
         std::string decoded(URI::percentDecode(URI::percentDecode(data, end, data.length() - end)));
         errorFlag = !decodeBase64(content, decoded);
     }
-    content.flush();
+    if (!flushContent())
+        errorFlag = true;
+    else
+        octetCount = buffering ? memoryContent.length() : static_cast<unsigned long long>(this->content.tellp());
     notify(errorFlag);
     return errorFlag;
 }
@@ -305,6 +465,7 @@ bool HttpRequest::send()
         struct stat status;
         if (stat(filePath.c_str(), &status) == 0 && S_ISREG(status.st_mode)) {
             lastModified = status.st_mtime;
+            octetCount = status.st_size;
             return notify(false);
         }
         return notify(true);
@@ -321,6 +482,7 @@ bool HttpRequest::send()
         struct stat status;
         if (stat(filePath.c_str(), &status) == 0 && S_ISREG(status.st_mode)) {
             lastModified = status.st_mtime;
+            octetCount = status.st_size;
             return notify(false);
         }
         return notify(true);
@@ -348,9 +510,13 @@ void HttpRequest::abort()
     errorFlag = false;
     request.clear();
     response.clear();
-    if (content.is_open())
-        content.close();
+    clearContent();
+    unpinFile();
     filePath.clear();   // TODO: Check if we should remove file now
+    octetCount = 0;
+    progressCount = 0;
+    resumeOffset = 0;
+    resumePath.clear();
     cache = 0;
 }
 
@@ -395,10 +561,18 @@ HttpRequest::HttpRequest(const std::u16string& base) :
     base(base),
     readyState(UNSENT),
     flags(DONT_REMOVE),
+    priority(DEFAULT_PRIORITY),
     errorFlag(false),
+    pinned(false),
+    memory(boost::iostreams::back_inserter(memoryContent)),
+    buffering(false),
+    octetCount(0),
     cache(0),
     handler(0),
+    progressCount(0),
+    progressQueued(false),
     lastModified(0),
+    resumeOffset(0),
     boxImage(0)
 {
 }
@@ -408,6 +582,7 @@ HttpRequest::~HttpRequest()
     if (!(flags & DONT_REMOVE))
         removeFile();
     abort();
+    unpinFile();
     delete boxImage;
 }
 
@@ -17,11 +17,17 @@
 #ifndef ES_HTTP_REQUEST_H
 #define ES_HTTP_REQUEST_H
 
+#include <atomic>
 #include <fstream>
 #include <cstdio>
 #include <deque>
+#include <memory>
+#include <sstream>
 #include <boost/function.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
 
+#include "http/HTTPContentSpan.h"
 #include "http/HTTPRequestMessage.h"
 #include "http/HTTPResponseMessage.h"
 
@@ -34,7 +40,9 @@ class HttpCache;
 
 class HttpRequest
 {
+    friend class HttpCache;
     friend class HttpCacheManager;
+    friend class HttpConnection;
     friend class HttpConnectionManager;
 
 public:
@@ -50,28 +58,61 @@ public:
     static const unsigned short DONT_REMOVE = 1;    // Do not remove filePath upon destruction
     static const unsigned short CANCELED = 2;
 
+    // priorities, the highest first
+    static const unsigned short DOCUMENT_PRIORITY = 0;
+    static const unsigned short BLOCKING_PRIORITY = 1;  // for scripts and style sheets
+    static const unsigned short DEFAULT_PRIORITY = 2;
+    static const unsigned short LOW_PRIORITY = 3;       // for images and prefetches
+
+    // Contents up to this size are kept in memory rather than in a file.
+    static const size_t MaxContentBufferSize = 32 * 1024;
+
 private:
     static std::string aboutPath;
     static std::string cachePath;
 
     std::u16string base;
-    unsigned short readyState;
+    std::atomic_ushort readyState;  // set on the I/O thread while LOADING
     std::atomic_ushort flags;
+    unsigned short priority;
     bool errorFlag;
     HttpRequestMessage request;
     HttpResponseMessage response;
 
     std::string filePath;
+    bool pinned;                    // true if filePath is shared with the cache
     std::fstream content;
+    std::string memoryContent;      // the content being downloaded into memory
+    boost::iostreams::stream<boost::iostreams::back_insert_device<std::string>> memory;  // writes to memoryContent
+    bool buffering;                 // true while the content is written to memory
+    std::shared_ptr<std::string> buffer;    // the content kept in memory
+    HttpContentSpan span;
+    std::atomic_ullong octetCount;  // the number of octets written to content so far
 
     HttpCache* cache;
     boost::function<void (void)> handler;
+    boost::function<void (unsigned long long, unsigned long long)> progressHandler;
+    unsigned long long progressCount;   // the number of octets notified to progressHandler
+    bool progressQueued;                // guarded by the HttpConnectionManager mutex
     long long lastModified;
+    std::string contentCharset;         // guarded by the HttpConnectionManager mutex while LOADING
+
+    // for resuming the content with a range request
+    unsigned long long resumeOffset;    // the length of the partial content; 0 if not resuming
+    std::string resumePath;             // the partial content kept in the cache, if any
+    HttpResponseMessage resumeResponse; // the head of the partial content
 
     std::deque<boost::function<void (void)>> callbackList;
 
     BoxImage* boxImage;
 
+    static int createTempFile(std::string& path);
+    std::fstream& createFile();
+    bool flushContent();
+    void clearContent();
+    void pinFile();
+    void unpinFile();
+
 public:
     HttpRequest(const std::u16string& base = u"");
     ~HttpRequest();
@@ -85,23 +126,49 @@ public:
     HttpResponseMessage& getResponseMessage() {
         return response;
     }
+    // Returns the charset of the content. Unlike getResponseMessage(), it
+    // can be called while the readyState is LOADING, as the I/O thread may
+    // still update the response headers.
+    std::string getContentCharset();
 
     const std::string& getFilePath() const {
         return filePath;
     }
-    void removeFile() {
-        if (!filePath.empty()) {
-            remove(filePath.c_str());
-            filePath.clear();
-        }
+    // Removes the content file, or releases it if it is shared with the
+    // cache.
+    void removeFile();
+
+    // Returns the content kept in memory, or null if the content is in the
+    // file. The content of a document is always saved in a file so that it
+    // can be read while it is being downloaded.
+    const std::shared_ptr<std::string>& getContentBuffer() const {
+        return buffer;
     }
 
+    // Returns the content of the completed request without copying it. The
+    // span is shared with the cache and remains valid while it is kept.
+    const HttpContentSpan& getContentSpan();
+
+    // Returns a new descriptor to read the content saved in the file, or -1
+    // if the content is kept in memory, which is to be read from the span.
     int getContentDescriptor();
-    std::fstream& getContent();
+    std::ostream& getContent();
+    // Returns the number of octets of the content that can be read from
+    // the content descriptor so far, while the readyState is LOADING.
+    unsigned long long getContentOctetCount() const {
+        return octetCount;
+    }
     std::FILE* openFile();
 
     void setHandler(boost::function<void (void)> f);
     void clearHandler();
+    // Sets the handler to be called with each range of the content that has
+    // been newly received, while the content is being downloaded and once
+    // more upon completion. The range can be read from the content
+    // descriptor at once. Unlike the other handlers, it remains set after
+    // abort().
+    void setProgressHandler(boost::function<void (unsigned long long offset, unsigned long long length)> f);
+    void notifyProgress();
     unsigned addCallback(boost::function<void (void)> f, unsigned id = static_cast<unsigned>(-1));
     void clearCallback(unsigned id);
 
@@ -128,6 +195,15 @@ public:
         return flags & CANCELED;
     }
 
+    // Requests with a higher priority are sent before the lower ones to the
+    // same host. Set the priority before calling send().
+    unsigned short getPriority() const {
+        return priority;
+    }
+    void setPriority(unsigned short value) {
+        priority = value;
+    }
+
     unsigned short getStatus() const;
     const std::string& getStatusText() const;
     const std::string getResponseHeader(std::u16string header) const;
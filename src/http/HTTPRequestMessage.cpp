@@ -53,6 +53,7 @@ void HttpRequestMessage::open(const std::string& method, const std::u16string& u
     toUpperCase(this->method);
     this->url = URL(url);
     setHeader("User-Agent", "Escudo/" PACKAGE_VERSION);
+    setHeader("Accept-Encoding", "gzip, deflate");
 }
 
 bool HttpRequestMessage::redirect(const std::u16string& url)
@@ -69,6 +70,11 @@ void HttpRequestMessage::setHeader(const std::string& header, const std::string&
     headers.set(header, value);
 }
 
+void HttpRequestMessage::removeHeader(const std::string& header)
+{
+    headers.erase(header);
+}
+
 void HttpRequestMessage::clear()
 {
     version = 11;
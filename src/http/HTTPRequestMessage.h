@@ -75,6 +75,7 @@ public:
     void open(const std::string& method, const std::u16string& url);
     bool redirect(const std::u16string& url);
     void setHeader(const std::string& header, const std::string& value);
+    void removeHeader(const std::string& header);
 
     void clear();
 
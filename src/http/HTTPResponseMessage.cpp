@@ -56,25 +56,21 @@ bool hasToken(const std::string& value, const char* token, size_t length, char s
     return false;
 }
 
-bool isHopByHopHeader(const std::string& header)
+bool isHopByHopHeader(const HttpHeader& header)
 {
-    const char* names[] = {
-        "Connection",
-        "Keep-Alive",
-        "Proxy-Authenticate",
-        "Proxy-Authorization",
-        "TE",
-        "Trailers",
-        "Transfer-Encoding",
-        "Upgrade",
-        0
-    };
-    const char* h = header.c_str();
-    for (const char** i = names; *i; ++i) {
-        if (strcasecmp(*i, h) == 0)
-            return true;
+    switch (header.id) {
+    case HttpHeader::Connection:
+    case HttpHeader::KeepAlive:
+    case HttpHeader::ProxyAuthenticate:
+    case HttpHeader::ProxyAuthorization:
+    case HttpHeader::TE:
+    case HttpHeader::Trailer:
+    case HttpHeader::TransferEncoding:
+    case HttpHeader::Upgrade:
+        return true;
+    default:
+        return false;
     }
-    return false;
 }
 
 }
@@ -123,23 +119,15 @@ const char* HttpResponseMessage::parseStatusLine(const char* start, const char*
             ++start;
             text = start;
         }
-        const char* textEnd = 0;
-        while (start < end) {
-            if (*start == '\n') {
-                if (!textEnd)
-                    textEnd = start;
-                break;
-            }
-            if (*start == '\r') {
-                if (!textEnd)
-                    textEnd = start;
-            }
-            ++start;
-        }
+        start = findLF(start, end);
         if (!text)
             statusText = "OK";
-        else if (textEnd)
-            statusText = std::string(text, textEnd - text);
+        else {
+            const char* textEnd = text;
+            while (textEnd < start && *textEnd != '\r')
+                ++textEnd;
+            statusText.assign(text, textEnd - text);
+        }
     }
     return start;
 }
@@ -213,6 +201,11 @@ bool HttpResponseMessage::parseCacheControl(const std::string& value)
 {
     const char* start = value.c_str();
     const char* end = start + value.length();
+    // Note a later Cache-Control field replaces the earlier one.
+    const char* maxAgeValue = strcasestr(start, "max-age=");
+    hasMaxAge = (maxAgeValue != 0);
+    if (hasMaxAge)
+        parseDigits(maxAgeValue + 8, end, maxAge);
     do {
         start = skipSpace(start, end);
         if (isToken(start, "no-cache", 8) && start[8] != '=')
@@ -241,110 +234,126 @@ bool HttpResponseMessage::parsePragma(const std::string& value)
     return true;
 }
 
-unsigned HttpResponseMessage::getAgeValue() const
-{
-    unsigned age = 0;
-    std::string value;
-    if (headers.get("Age", value))
-        parseDigits(value.c_str(), value.c_str() + value.length(), age);
-    return age;
-}
-
-long long HttpResponseMessage::getDateValue() const
-{
-    long long date = 0;
-    std::string value;
-    if (headers.get("Date", value))
-        parseTime(value.c_str(), value.c_str() + value.length(), date);
-    return date;
-}
-
 bool HttpResponseMessage::isChunked() const
 {
-    std::string value;
-    if (!headers.get("Transfer-Encoding", value))
-        return false;
-    return hasToken(value, "chunked", 7);
+    const std::string* value = headers.find(HttpHeader::TransferEncoding);
+    return value && hasToken(*value, "chunked", 7);
 }
 
-bool HttpResponseMessage::getExpiresValue(long long& expiresValue) const
+// cf. http://tools.ietf.org/html/draft-ietf-httpbis-p5-range-22#section-3.2
+std::string HttpResponseMessage::getRangeValidator() const
 {
-    std::string value;
-    if (headers.get("Expires", value)) {
-        parseTime(value.c_str(), value.c_str() + value.length(), expiresValue);
-        return true;
-    }
-    return false;
+    const std::string* value = headers.find(HttpHeader::AcceptRanges);
+    if (value && hasToken(*value, "none", 4))
+        return "";
+    // Only strong validators can be used.
+    value = headers.find(HttpHeader::ETag);
+    if (value && value->compare(0, 2, "W/") != 0)
+        return *value;
+    if (dateValue && hasLastModified && 60 <= dateValue - lastModifiedValue)
+        return getResponseHeader(HttpHeader::LastModified);
+    return "";
 }
 
-bool HttpResponseMessage::getMaxAgeValue(unsigned& maxAge) const
+bool HttpResponseMessage::getContentRange(unsigned long long& first, unsigned long long& last, unsigned long long& length) const
 {
-    std::string value;
-    if (!headers.get("Cache-Control", value))
+    const std::string* value = headers.find(HttpHeader::ContentRange);
+    if (!value)
         return false;
-    const char* s = value.c_str();
-    s = strcasestr(s, "max-age=");
-    if (!s)
+    const char* p = skipSpace(value->c_str(), value->c_str() + value->length());
+    const char* end = value->c_str() + value->length();
+    if (end - p < 5 || strncasecmp(p, "bytes", 5) != 0)
         return false;
-    parseDigits(s + 8, value.c_str() + value.length(), maxAge);
-    return true;
-}
-
-bool HttpResponseMessage::getLastModifiedValue(long long& lastModifiedValue) const
-{
-    std::string value;
-    if (headers.get("Last-Modified", value)) {
-        parseTime(value.c_str(), value.c_str() + value.length(), lastModifiedValue);
+    p = skipSpace(p + 5, end);
+    if (p == end || !isdigit(*p))
+        return false;
+    p = parseDigits(p, end, first);
+    if (p == end || *p != '-' || ++p == end || !isdigit(*p))
+        return false;
+    p = parseDigits(p, end, last);
+    if (p == end || *p != '/' || ++p == end || last < first)
+        return false;
+    if (*p == '*') {
+        length = 0;
         return true;
     }
-    return false;
+    if (!isdigit(*p))
+        return false;
+    parseDigits(p, end, length);
+    return last < length;
 }
 
 bool HttpResponseMessage::parseHeader(const HttpHeader& hdr)
 {
     if (hdr.value.empty())
         return false;
-    if (hdr == "Content-Length") {
+    const char* start = hdr.value.c_str();
+    const char* end = start + hdr.value.length();
+    switch (hdr.id) {
+    case HttpHeader::ContentLength:
         if (parseContentLength(hdr.value)) {
             hasContentLength = true;
             return true;
         }
         return false;
-    }
-    if (hdr == "Content-Type")
+    case HttpHeader::ContentType:
         return parseContentType(hdr.value);
-    if (hdr == "Cache-Control")
+    case HttpHeader::CacheControl:
         return parseCacheControl(hdr.value);
-    if (hdr == "Pragma")
+    case HttpHeader::Pragma:
         return parsePragma(hdr.value);
-    return true;
+    case HttpHeader::Age:
+        ageValue = 0;
+        parseDigits(start, end, ageValue);
+        return true;
+    case HttpHeader::Date:
+        dateValue = 0;
+        parseTime(start, end, dateValue);
+        return true;
+    case HttpHeader::Expires:
+        expiresValue = 0;
+        parseTime(start, end, expiresValue);
+        hasExpires = true;
+        return true;
+    case HttpHeader::LastModified:
+        lastModifiedValue = 0;
+        parseTime(start, end, lastModifiedValue);
+        hasLastModified = true;
+        return true;
+    default:
+        return true;
+    }
 }
 
 const char* HttpResponseMessage::parseHeader(const char* start, const char* const end)
 {
-    HttpHeader hdr;
+    const HttpHeader* hdr;
     start = headers.parseLine(start, end, &hdr);
     if (!start)
         return 0;
-    parseHeader(hdr);
+    if (hdr)
+        parseHeader(*hdr);
     return start;
 }
 
+// Parses the message head in [start, end) without copying it line by line.
+// Returns the position of the LF that ends the head, or end if the head is
+// not terminated by an empty line.
 const char* HttpResponseMessage::parse(const char* start, const char* const end)
 {
     const char* header = parseStatusLine(start, end);
     if (version < 10)
         return 0;
-    if (*header != '\n')
+    if (header == end || *header != '\n')
         return 0;
     ++header;
     while (header < end) {
+        const char* eol = parseCRLF(header, end);
+        if (eol < end && *eol == '\n')
+            return eol;
         header = parseHeader(header, end);
         if (!header)
             return 0;
-        header = parseCRLF(header, end);
-        if (*header == '\n')
-            break;
     }
     return header;
 }
@@ -368,10 +377,9 @@ std::string HttpResponseMessage::toString() const
 long long HttpResponseMessage::getCurrentAge(long long now, long long requestTime) const
 {
     long long currentAge = 0;
-    long long dateValue = getDateValue();
     if (dateValue && dateValue < now)
         currentAge = now - dateValue;
-    currentAge = std::max(currentAge, static_cast<long long>(getAgeValue()));
+    currentAge = std::max(currentAge, static_cast<long long>(ageValue));
     currentAge += now;
     currentAge -= requestTime;
     return currentAge;
@@ -379,25 +387,18 @@ long long HttpResponseMessage::getCurrentAge(long long now, long long requestTim
 
 long long HttpResponseMessage::getFreshnessLifetime(long long now) const
 {
-    unsigned lifetime = 0;
-    if (getMaxAgeValue(lifetime))
-        return lifetime;
-
-    long long dateValue = getDateValue();
-    if (dateValue == 0)
-        dateValue = now;
-
-    long long expiresValue = 0;
-    if (getExpiresValue(expiresValue)) {
-        if (dateValue < expiresValue)
-            return expiresValue - dateValue;
+    if (hasMaxAge)
+        return maxAge;
+
+    long long date = dateValue ? dateValue : now;
+    if (hasExpires) {
+        if (date < expiresValue)
+            return expiresValue - date;
         return 0;
     }
-
-    long long lastModifiedValue = 0;
-    if (getLastModifiedValue(lastModifiedValue)) {
-        if (lastModifiedValue <= dateValue)
-            return (dateValue - lastModifiedValue) / 10;
+    if (hasLastModified) {
+        if (lastModifiedValue <= date)
+            return (date - lastModifiedValue) / 10;
     }
 
     if (status == 300 || status == 301)
@@ -423,12 +424,9 @@ bool HttpResponseMessage::isCacheable() const
         if (!isNoCache())
             cacheable = true;
         break;
-    default: {
-            unsigned maxAge;
-            long long expires;
-            if (getMaxAgeValue(maxAge) || getExpiresValue(expires))
-                cacheable = true;
-        }
+    default:
+        if (hasMaxAge || hasExpires)
+            cacheable = true;
         break;
     }
     return cacheable;
@@ -443,6 +441,14 @@ bool HttpResponseMessage::isFresh(long long requestTime) const
     return currentAge < freshnessLifetime;
 }
 
+void HttpResponseMessage::setDecodedContentLength(unsigned long long length)
+{
+    headers.erase(HttpHeader::getName(HttpHeader::ContentEncoding));
+    headers.set(HttpHeader::getName(HttpHeader::ContentLength), std::to_string(length));
+    hasContentLength = true;
+    contentLength = length;
+}
+
 void HttpResponseMessage::clear()
 {
     version = 11;
@@ -455,24 +461,30 @@ void HttpResponseMessage::clear()
     contentCharset.clear();
     contentLength = 0;
     contentType.clear();
+    dateValue = 0;
+    expiresValue = 0;
+    lastModifiedValue = 0;
+    ageValue = 0;
+    maxAge = 0;
+    hasExpires = false;
+    hasLastModified = false;
+    hasMaxAge = false;
 }
 
 void HttpResponseMessage::update(const HttpResponseMessage& response)
 {
+    // The header fields describing the range of a 206 (Partial Content)
+    // response do not apply to the combined content.
+    // cf. http://tools.ietf.org/html/draft-ietf-httpbis-p5-range-22#section-4.3
+    bool partial = response.getStatus() == 206;
     for (auto i = response.headers.begin(); i !=response.headers.end(); ++i) {
-        if (isHopByHopHeader(i->header))
+        if (isHopByHopHeader(*i))
             continue;
-        headers.set(i->header, i->value, false);
+        if (partial && (i->id == HttpHeader::ContentLength || i->id == HttpHeader::ContentRange))
+            continue;
+        headers.set(*i, false);
         parseHeader(*i);
     }
-
-    // TODO:
-    // 13.5.3
-    // If the status code is 206 (Partial Content) and the ETag or
-    // Last-Modified headers match exactly, the cache MAY combine the
-    // contents stored in the cache entry with the new contents received in
-    // the response and use the result as the entity-body of this outgoing
-    // response
 }
 
 HttpResponseMessage::HttpResponseMessage()
@@ -38,6 +38,17 @@ class HttpResponseMessage
     unsigned long long contentLength;
     std::string contentType;
 
+    // The values of the header fields used for the freshness computations,
+    // kept parsed so that they can be tested without any string work.
+    long long dateValue;            // 0 if none
+    long long expiresValue;
+    long long lastModifiedValue;
+    unsigned ageValue;
+    unsigned maxAge;
+    bool hasExpires;
+    bool hasLastModified;
+    bool hasMaxAge;
+
     const char* parseVersion(const char* start, const char* const end);
     bool parseContentLength(const std::string& value);
     bool parseContentType(const std::string& value);
@@ -96,6 +107,11 @@ public:
             return value;
         return "";  // TODO: or null?
     }
+    // id is one of the well-known header IDs defined in HttpHeader.
+    std::string getResponseHeader(int id) const {
+        const std::string* value = headers.find(id);
+        return value ? *value : "";
+    }
     std::string getAllResponseHeaders() const {
         return headers.toString();  // TODO: remove unwanted headers
     }
@@ -106,12 +122,31 @@ public:
 
     std::string toString() const;
 
-    unsigned getAgeValue() const;
-    long long getDateValue() const;
+    unsigned getAgeValue() const {
+        return ageValue;
+    }
+    long long getDateValue() const {
+        return dateValue;
+    }
 
-    bool getExpiresValue(long long& expiresValue) const;
-    bool getMaxAgeValue(unsigned& maxAge) const;
-    bool getLastModifiedValue(long long& lastModifiedValue) const;
+    bool getExpiresValue(long long& value) const {
+        if (!hasExpires)
+            return false;
+        value = expiresValue;
+        return true;
+    }
+    bool getMaxAgeValue(unsigned& value) const {
+        if (!hasMaxAge)
+            return false;
+        value = maxAge;
+        return true;
+    }
+    bool getLastModifiedValue(long long& value) const {
+        if (!hasLastModified)
+            return false;
+        value = lastModifiedValue;
+        return true;
+    }
 
     long long getCurrentAge(long long now, long long requestTime) const;
     long long getFreshnessLifetime(long long now) const;
@@ -127,6 +162,17 @@ public:
 
     bool isChunked() const;
 
+    // Returns the validator to be sent in If-Range, or an empty string if
+    // the transfer of the content cannot be resumed.
+    std::string getRangeValidator() const;
+    // Gets the Content-Range of a 206 response. length is set to zero if
+    // the complete length is unknown.
+    bool getContentRange(unsigned long long& first, unsigned long long& last, unsigned long long& length) const;
+
+    // Lets the head describe the content decoded from the Content-Encoding
+    // as it is kept by the cache.
+    void setDecodedContentLength(unsigned long long length);
+
     void clear();
     void update(const HttpResponseMessage& response);
     void updateStatus(const HttpResponseMessage& response) {
@@ -319,6 +319,21 @@ const char* parseCRLF(const char* start, const char* const end)
     return start;
 }
 
+const char* findEndOfHead(const char* start, const char* const end, const char*& next)
+{
+    while (start < end) {
+        const char* eol = parseCRLF(start, end);
+        if (eol < end && *eol == '\n')
+            return eol + 1;
+        eol = findLF(eol, end);
+        if (eol == end)
+            break;
+        start = eol + 1;
+    }
+    next = start;
+    return 0;
+}
+
 }  // http
 
 }}}}  // org::w3c::dom::bootstrap
@@ -17,6 +17,7 @@
 #ifndef ES_HTTP_UTIL_H
 #define ES_HTTP_UTIL_H
 
+#include <cstring>
 #include <string>
 
 namespace org { namespace w3c { namespace dom { namespace bootstrap {
@@ -47,6 +48,19 @@ const char* parseTime(const char* start, const char* const end, long long& t);
 // parseCRLF(): if start begins with CRLF, the result points to LF.
 const char* parseCRLF(const char* start, const char* const end);
 
+// findLF(): returns the first LF in [start, end), or end if there is none.
+// memchr() compares a machine word or a vector register at a time.
+inline const char* findLF(const char* start, const char* const end)
+{
+    const void* lf = (start < end) ? memchr(start, '\n', end - start) : 0;
+    return lf ? static_cast<const char*>(lf) : end;
+}
+// findEndOfHead(): returns the position just after the empty line that ends
+// the header fields beginning at start, or 0 if the empty line has not been
+// found in [start, end). In the latter case, next is set to the beginning
+// of the incomplete line from which the scan can be continued.
+const char* findEndOfHead(const char* start, const char* const end, const char*& next);
+
 }  // http
 
 }}}}  // org::w3c::dom::bootstrap